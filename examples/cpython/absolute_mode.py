@@ -49,7 +49,7 @@ def print_data(timeout=6):
     )
     start = time.monotonic()
     while time.monotonic() - start < timeout:
-        while trackpad.available():  # is there new data?
+        while trackpad.wait_available(100):  # is there new data? (waits up to 100 ms)
             trackpad.read(data)
 
             # specification sheet recommends clamping absolute position data of
@@ -72,7 +72,7 @@ def print_trig(timeout=6):
     )
     start = time.monotonic()
     while time.monotonic() - start < timeout:
-        while trackpad.available():  # is there new data?
+        while trackpad.wait_available(100):  # is there new data? (waits up to 100 ms)
             trackpad.read(data)
 
             if not data.z:  # if not touching (or near) the sensor
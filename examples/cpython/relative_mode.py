@@ -44,7 +44,7 @@ def print_data(timeout=6):
     )
     start = time.monotonic()
     while time.monotonic() - start < timeout:
-        while trackpad.available():  # is there new data?
+        while trackpad.wait_available(100):  # is there new data? (waits up to 100 ms)
             trackpad.read(data)
             print(data)
             start = time.monotonic()
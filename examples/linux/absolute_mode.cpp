@@ -58,7 +58,7 @@ bool setup()
 
 void loop()
 {
-    if (trackpad.available()) {
+    if (trackpad.waitAvailable(1000)) { // sleeps until there is new data (or 1 second passes)
         trackpad.read(&data);
 
         // datasheet recommends clamping the axes value to reliable range
@@ -93,7 +93,7 @@ void loop()
                 std::cout << std::setprecision(5) << "angle: " << angle << "\tradius: " << radius << std::endl;
             }
         }
-    } // end if trackpad.available()
+    } // end if trackpad.waitAvailable()
 } //end loop()
 
 int main()
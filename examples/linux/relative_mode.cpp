@@ -37,7 +37,7 @@ bool setup()
 
 void loop()
 {
-    if (trackpad.available()) {
+    if (trackpad.waitAvailable(1000)) { // sleeps until there is new data (or 1 second passes)
         trackpad.read(&data);
         std::cout << "Left:" << (unsigned int)(data.buttons & 1)
                   << " Right:" << (unsigned int)(data.buttons & 2)
@@ -18,11 +18,24 @@
  */
 #include "CirquePinnacle.h"
 #ifdef PINNACLE_SPI_BUFFER_OPS
-    #include <cstdlib> // malloc(), free()
     #include <cstring> // memcpy(), memset()
+
+// rapReadPacket() needs room for the largest packet (3 + 6 bytes) and a Status register write
+static_assert(PINNACLE_SPI_BUFFER_SIZE >= 11, "PINNACLE_SPI_BUFFER_SIZE must be at least 11 bytes");
+#endif
+
+using namespace pinnacle_registers;
+
+#ifdef PINNACLE_I2C_BUFFER_LENGTH
+    #define PINNACLE_I2C_TX_LIMIT PINNACLE_I2C_BUFFER_LENGTH
+#else
+    #define PINNACLE_I2C_TX_LIMIT 32 // the transmit buffer size of Arduino's Wire library
 #endif
 
-PinnacleTouch::PinnacleTouch(pinnacle_gpio_t dataReadyPin) : _dataMode(PINNACLE_ERROR), _rev2025(false), _dataReady(dataReadyPin)
+PinnacleTouch::PinnacleTouch(pinnacle_gpio_t dataReadyPin)
+    : _dataMode(PINNACLE_ERROR), _rev2025(false), _cacheEnabled(false), _cacheValid(false), _eraFeedState(false), _eraDepth(0), _busDepth(0),
+      _eraQueueHead(0), _eraQueueCount(0), _eraQueueActive(false),
+      _eraQueueHeld(false), _dataReady(dataReadyPin), _clearPending(false), _clearTime(0)
 {
     PINNACLE_USE_ARDUINO_API
     pinMode(_dataReady, INPUT);
@@ -32,39 +45,89 @@ bool PinnacleTouch::begin()
 {
     PINNACLE_USE_ARDUINO_API
     delay(100);
-    uint8_t buffer[3] = {0}; // index 2 is relative mode defaults
-    rapReadBytes(PINNACLE_FIRMWARE_ID, buffer, 2);
-    _rev2025 = buffer[0] == 0x0E && buffer[1] == 0x75;
-    if (_rev2025 || (buffer[0] == 7 && buffer[1] == 0x3A)) {
-        _dataMode = PINNACLE_RELATIVE;
-        buffer[0] = 0; // config power (defaults) and disable anymeas flags
-        buffer[1] = 0; // config absolute mode defaults and disable feed
-        rapWriteBytes(PINNACLE_SYS_CONFIG, buffer, 3);
-        setSampleRate(100);
-        rapWrite(PINNACLE_Z_IDLE, 30); // 30 z-idle packets
-        while (available()) {
-            clearStatusFlags(); // ignore/discard all pending measurements waiting to be read()
-        }
-        if (!_rev2025) {
-            setAdcGain(0); // most sensitive attenuation
-        }
-        if (calibrate()) { // enables all compensations, runs calibration, & clearStatusFlags()
-            feedEnabled(true);
-            return true;
-        }
+    return configure(nullptr);
+}
+
+bool PinnacleTouch::fastBegin(const PinnacleConfigSnapshot* snapshot)
+{
+    PINNACLE_USE_ARDUINO_API
+    // poll the firmware ID until the Pinnacle answers (instead of always waiting 100 ms)
+    uint32_t start = millis();
+    uint8_t buffer[2] = {0};
+    while (true) {
+        rapReadBytes(FirmwareId::address, buffer, 2);
+        if ((buffer[0] == 0x0E && buffer[1] == 0x75) || (buffer[0] == 7 && buffer[1] == 0x3A))
+            break;
+        if ((uint32_t)(millis() - start) >= PINNACLE_BOOT_TIMEOUT)
+            break; // let configure() fail the hardware check
+        delay(1);
     }
-    // else if hardware check failed
-    _dataMode = PINNACLE_ERROR; // prevent further operations if hardware check failed
-    return false;
+    return configure(snapshot);
+}
+
+bool PinnacleTouch::configure(const PinnacleConfigSnapshot* snapshot)
+{
+    PINNACLE_USE_ARDUINO_API
+    _cacheValid = false; // discard anything mirrored from a previous session
+    _intellimouse = false;
+    eraQueueClear(); // don't resume operations meant for the previous session
+    _eraDepth = 0;
+    uint8_t buffer[2] = {0};
+    uint8_t config[4] = {0}; // SYS_CONFIG through FEED_CONFIG_3
+    // config[0]: config power (defaults) and disable anymeas flags
+    // config[1]: config absolute mode defaults and disable feed
+    // config[2]: config relative mode defaults
+    // config[3]: enable palm & noise compensations (same as setSampleRate(100))
+    uint8_t timing[2] = {100, 30}; // 100 samples per second, 30 z-idle packets
+    RapOperation setup[] = {
+        {SysConfig::address, config, 4, false},
+        {SampleRate::address, timing, 2, false},
+    };
+    {
+        // Only the hardware check and the initial setup are sent in 1 session. The calibration
+        // and extended register accesses below wait on the Pinnacle ASIC, so they release the
+        // bus between register accesses (for other devices on the same bus).
+        BusSession session(this);
+        rapReadBytes(FirmwareId::address, buffer, 2);
+        _rev2025 = buffer[0] == 0x0E && buffer[1] == 0x75;
+        // prevent further operations if hardware check failed
+        _dataMode = (_rev2025 || (buffer[0] == 7 && buffer[1] == 0x3A)) ? PINNACLE_RELATIVE : PINNACLE_ERROR;
+        if (_dataMode == PINNACLE_ERROR)
+            return false;
+        cachedSubmit(setup, 2);
+    }
+    if (!_rev2025 && !snapshot) {
+        eraWriteBytes(ReloadTimer::address, 0x13, 2); // reload timer for 100 samples per second
+    }
+    // ignore/discard all pending measurements waiting to be read()
+    while (digitalRead(_dataReady)) {
+        clearStatusFlags();
+        delayMicroseconds(50); // the DR pin may stay active for up to 50 us after the clear
+    }
+    if (!_rev2025 && !snapshot) {
+        setAdcGain(0); // most sensitive attenuation
+    }
+    // a snapshot's compensation matrix is restored instead of calibrating again
+    if ((!snapshot || _rev2025) && !calibrate()) { // enables all compensations, runs calibration, & clearStatusFlags()
+        _dataMode = PINNACLE_ERROR;
+        return false;
+    }
+    if (snapshot) {
+        restoreConfig(snapshot, nullptr); // includes the feed's state
+        clearStatusFlags();          // discard anything measured with the previous configuration
+    }
+    else
+        feedEnabled(true);
+    return true;
 }
 
 void PinnacleTouch::feedEnabled(bool isEnabled)
 {
     if (_dataMode == PINNACLE_ABSOLUTE || _dataMode == PINNACLE_RELATIVE) {
         uint8_t temp = 0;
-        rapRead(PINNACLE_FEED_CONFIG_1, &temp);
-        if (static_cast<bool>(temp & 1) != isEnabled)
-            rapWrite(PINNACLE_FEED_CONFIG_1, (temp & 0xFE) | isEnabled);
+        cachedRead(FeedConfig1::address, &temp);
+        if (static_cast<bool>(FeedEnable::get(temp)) != isEnabled)
+            cachedWrite(FeedConfig1::address, FeedEnable::set(isEnabled).apply(temp));
     }
 }
 
@@ -72,45 +135,66 @@ bool PinnacleTouch::isFeedEnabled()
 {
     if (_dataMode == PINNACLE_ABSOLUTE || _dataMode == PINNACLE_RELATIVE) {
         uint8_t temp = 0;
-        rapRead(PINNACLE_FEED_CONFIG_1, &temp);
-        return static_cast<bool>(temp & 1);
+        cachedRead(FeedConfig1::address, &temp);
+        return static_cast<bool>(FeedEnable::get(temp));
     }
     /* AnyMeas mode: "feed" is instigated by measureADC()
        & x/y tracking measurements are already disabled */
     return false;
 }
 
+void PinnacleTouch::registerCacheEnabled(bool isEnabled)
+{
+    _cacheEnabled = isEnabled;
+    _cacheValid = false; // (re)populate on next use
+}
+
+bool PinnacleTouch::isRegisterCacheEnabled()
+{
+    return _cacheEnabled;
+}
+
 void PinnacleTouch::setDataMode(PinnacleDataMode mode)
 {
     PINNACLE_USE_ARDUINO_API
     if (mode <= PINNACLE_ABSOLUTE && _dataMode != PINNACLE_ERROR) {
         uint8_t sysConfig = 0;
-        rapRead(PINNACLE_SYS_CONFIG, &sysConfig);
-        sysConfig &= 0xE7; // clears AnyMeas flags
+        cachedRead(SysConfig::address, &sysConfig);
+        sysConfig = AnyMeas::set(0).apply(sysConfig); // clears AnyMeas flags
         if (mode == PINNACLE_RELATIVE || mode == PINNACLE_ABSOLUTE) {
 #if PINNACLE_ANYMEAS_SUPPORT
             if (_dataMode == PINNACLE_ANYMEAS) { // if leaving AnyMeas mode
                 _dataMode = mode;
-                setSampleRate(100);
-                rapWrite(PINNACLE_CAL_CONFIG, 0x1E); // enables all compensations
-                rapWrite(PINNACLE_Z_IDLE, 30);       // 30 z-idle packets
-                uint8_t buffer[3] = {
+                if (!_rev2025) {
+                    eraWriteBytes(ReloadTimer::address, 0x13, 2); // reload timer for 100 samples per second
+                }
+                uint8_t config[5] = {
                     sysConfig,
-                    static_cast<uint8_t>(_dataMode | 1), // set new mode's flag, & enables feed
-                    0};                                  // config relative mode defaults
-                rapWriteBytes(PINNACLE_SYS_CONFIG, buffer, 3);
+                    // set new mode's flag, & enables feed
+                    (FeedEnable::set(1) | AbsoluteMode::set(_dataMode == PINNACLE_ABSOLUTE)).value,
+                    0, // config relative mode defaults
+                    0, // enable palm & noise compensations
+                    // enables all compensations
+                    (TapComp::set(1) | TrackErrorComp::set(1) | NerdComp::set(1) | BackgroundComp::set(1)).value};
+                uint8_t timing[2] = {100, 30};           // 100 samples per second, 30 z-idle packets
+                RapOperation setup[] = {
+                    {FeedConfig2::address, config + 2, 3, false},
+                    {SampleRate::address, timing, 2, false},
+                    {SysConfig::address, config, 2, false}, // enable the feed last
+                };
+                cachedSubmit(setup, 3);
             }
             else { // ok to just write appropriate mode
 
 #endif // PINNACLE_ANYMEAS_SUPPORT == true
                 _dataMode = mode;
-                rapWrite(PINNACLE_FEED_CONFIG_1, 1 | mode);
+                writeFields((FeedEnable::set(1) | AbsoluteMode::set(mode == PINNACLE_ABSOLUTE)).whole());
 #if PINNACLE_ANYMEAS_SUPPORT
             }
         }
         else if (mode == PINNACLE_ANYMEAS) {
             // disable tracking computations for AnyMeas mode
-            rapWrite(PINNACLE_SYS_CONFIG, sysConfig | 0x08);
+            cachedWrite(SysConfig::address, AnyMeas::set(1).apply(sysConfig));
             delay(10); // wait 10 ms for tracking measurements to expire
             _dataMode = mode;
             anymeasModeConfig(); // configure registers for the AnyMeas mode
@@ -134,8 +218,8 @@ bool PinnacleTouch::isHardConfigured()
 {
     if (_dataMode <= PINNACLE_ABSOLUTE) {
         uint8_t temp = 0;
-        rapRead(PINNACLE_HCO_ID, &temp);
-        return (temp & 0x80) > 0;
+        rapRead(HcoId::address, &temp);
+        return HardConfigured::get(temp);
     }
     return false;
 }
@@ -143,35 +227,75 @@ bool PinnacleTouch::isHardConfigured()
 bool PinnacleTouch::available()
 {
     PINNACLE_USE_ARDUINO_API
+    if (_clearPending) {
+        // DR pin may still be active if the Status register was cleared less than 50 us ago
+        if ((uint32_t)(micros() - _clearTime) < 50)
+            return false;
+        _clearPending = false;
+    }
     return digitalRead(_dataReady);
 }
 
+bool PinnacleTouch::waitAvailable(uint32_t timeout)
+{
+    PINNACLE_USE_ARDUINO_API
+#ifdef PINNACLE_GPIO_EDGE_EVENTS
+    // discard stale edges first, so an edge that happens after checking available() is not missed
+    GPIOClass::clearEdges(_dataReady);
+    if (_clearPending) {
+        // New data that arrived right after the Status register was cleared may have raised the
+        // DR pin before its stale edge was discarded. Wait out the rest of the window, so the DR
+        // pin's level is not ignored.
+        uint32_t elapsed = (uint32_t)(micros() - _clearTime);
+        if (elapsed < 50)
+            delayMicroseconds(50 - elapsed);
+    }
+    if (available())
+        return true;
+    if (GPIOClass::waitForEdge(_dataReady, timeout)) {
+        edgeConsumed(); // a rising edge is always new data
+        return true;
+    }
+    return false;
+#else  // !defined(PINNACLE_GPIO_EDGE_EVENTS)
+    uint32_t start = millis();
+    while (!available()) {
+        if ((uint32_t)(millis() - start) >= timeout)
+            return false;
+    }
+    return true;
+#endif // !defined(PINNACLE_GPIO_EDGE_EVENTS)
+}
+
 void PinnacleTouch::absoluteModeConfig(uint8_t zIdleCount, bool invertX, bool invertY)
 {
     if (_dataMode == PINNACLE_ABSOLUTE) {
-        rapWrite(PINNACLE_Z_IDLE, zIdleCount);
-        uint8_t temp = 0;
-        rapRead(PINNACLE_FEED_CONFIG_1, &temp);
-        rapWrite(PINNACLE_FEED_CONFIG_1, (temp & 0x3F) | (invertY << 7) | (invertX << 6));
+        cachedWrite(ZIdle::address, zIdleCount);
+        writeFields(InvertY::set(invertY) | InvertX::set(invertX));
     }
 }
 
 void PinnacleTouch::relativeModeConfig(bool taps, bool rotate90, bool secondaryTap, bool intellimouse, bool glideExtend)
 {
     if (_dataMode == PINNACLE_RELATIVE) {
-        uint8_t temp = (rotate90 << 7) | (!glideExtend << 4) | (!secondaryTap << 2) | (!taps << 1) | intellimouse;
-        rapWrite(PINNACLE_FEED_CONFIG_2, temp);
-        if (intellimouse) {
-            _intellimouse = false;
-            // send required cmd to enable intellimouse mode
-            uint8_t sequence[6] = {0xF3, 0xC8, 0xF3, 0x64, 0xF3, 0x50};
-            rapWriteCmd(sequence, 6);
-            // verify cmd was accepted with the device ID cmd
-            rapReadBytes(0xF2, sequence, 3);
-            if (sequence[0] == 0xFA && sequence[1] == 0x03) {
-                _intellimouse = true;
-            }
-        }
+        writeFields((Rotate90::set(rotate90) | GlideExtendDisable::set(!glideExtend) | SecondaryTapDisable::set(!secondaryTap)
+                     | TapsDisable::set(!taps) | Intellimouse::set(intellimouse))
+                        .whole());
+        if (intellimouse)
+            enableIntellimouse();
+    }
+}
+
+void PinnacleTouch::enableIntellimouse()
+{
+    _intellimouse = false;
+    // send required cmd to enable intellimouse mode
+    uint8_t sequence[6] = {0xF3, 0xC8, 0xF3, 0x64, 0xF3, 0x50};
+    rapWriteCmd(sequence, 6);
+    // verify cmd was accepted with the device ID cmd
+    rapReadBytes(0xF2, sequence, 3);
+    if (sequence[0] == 0xFA && sequence[1] == 0x03) {
+        _intellimouse = true;
     }
 }
 
@@ -180,16 +304,9 @@ void PinnacleTouch::read(RelativeReport* report, bool readButtons)
     if (_dataMode == PINNACLE_RELATIVE) {
         uint8_t buffer[4] = {0};
         uint8_t skip = !readButtons;
-        rapReadBytes(PINNACLE_PACKET_BYTE_0 + skip, buffer, 3 - skip + _intellimouse);
-        clearStatusFlags();
-        if (readButtons) {
-            report->buttons &= 0xF8;
-            report->buttons |= buffer[0] & 7;
-        }
-        report->x = (int8_t)buffer[1 - skip];
-        report->y = (int8_t)buffer[2 - skip];
-        if (_intellimouse)
-            report->scroll = (int8_t)buffer[3 - skip];
+        rapReadPacket(PacketByte0::address + skip, buffer, 3 - skip + _intellimouse);
+        statusCleared();
+        unpackReport(report, buffer, readButtons, _intellimouse);
     }
 }
 
@@ -198,33 +315,100 @@ void PinnacleTouch::read(AbsoluteReport* report, bool readButtons)
     if (_dataMode == PINNACLE_ABSOLUTE) {
         uint8_t buffer[6] = {0};
         uint8_t skip = (!readButtons) * 2;
-        rapReadBytes(PINNACLE_PACKET_BYTE_0 + skip, buffer, 6 - skip);
-        clearStatusFlags();
-        if (readButtons) {
-            report->buttons &= 0xF8;
-            report->buttons |= buffer[0] & 0x3F;
-        }
-        report->x = (uint16_t)(((buffer[4 - skip] & 0x0F) << 8) | buffer[2 - skip]);
-        report->y = (uint16_t)(((buffer[4 - skip] & 0xF0) << 4) | buffer[3 - skip]);
-        report->z = (uint8_t)(buffer[5 - skip] & 0x1F);
+        rapReadPacket(PacketByte0::address + skip, buffer, 6 - skip);
+        statusCleared();
+        unpackReport(report, buffer, readButtons);
     }
 }
 
-void PinnacleTouch::clearStatusFlags()
+void PinnacleTouch::readTimestamped(RelativeReport* report, uint64_t* timestamp, bool readButtons)
+{
+    *timestamp = dataReadyTimestamp();
+    read(report, readButtons);
+}
+
+void PinnacleTouch::readTimestamped(AbsoluteReport* report, uint64_t* timestamp, bool readButtons)
+{
+    *timestamp = dataReadyTimestamp();
+    read(report, readButtons);
+}
+
+uint64_t PinnacleTouch::dataReadyTimestamp()
 {
     PINNACLE_USE_ARDUINO_API
+#ifdef PINNACLE_GPIO_EDGE_EVENTS
+    return GPIOClass::edgeTimestamp(_dataReady);
+#else
+    return (uint64_t)micros() * 1000;
+#endif
+}
+
+void PinnacleTouch::clearStatusFlags()
+{
     if (_dataMode <= PINNACLE_ABSOLUTE) {
-        rapWrite(PINNACLE_STATUS, 0);
-        delayMicroseconds(50);
+        rapWrite(Status::address, 0);
+        statusCleared();
     }
 }
 
+void PinnacleTouch::statusCleared()
+{
+    PINNACLE_USE_ARDUINO_API
+    // instead of waiting for the DR pin to deactivate, let available() ignore it for a while
+    _clearTime = micros();
+    _clearPending = true;
+}
+
+void PinnacleTouch::edgeConsumed()
+{
+    _clearPending = false;
+}
+
+void PinnacleTouch::rapReadPacket(uint8_t registerAddress, uint8_t* data, uint8_t registerCount)
+{
+    BusSession session(this);
+    rapReadBytes(registerAddress, data, registerCount);
+    rapWrite(Status::address, 0);
+}
+
+void PinnacleTouch::rapSubmit(const RapOperation* operations, uint8_t count)
+{
+    BusSession session(this);
+    for (uint8_t i = 0; i < count; ++i) {
+        if (operations[i].read)
+            rapReadBytes(operations[i].address, operations[i].data, operations[i].count);
+        else
+            rapWriteBytes(operations[i].address, operations[i].data, operations[i].count);
+    }
+}
+
+const void* PinnacleTouch::busObject() const
+{
+    return nullptr;
+}
+
+#ifdef PINNACLE_BUS_LOCK
+void PinnacleTouch::lockBus()
+{
+}
+
+void PinnacleTouch::unlockBus()
+{
+}
+#endif
+
+void PinnacleTouch::beginBusTransaction()
+{
+}
+
+void PinnacleTouch::endBusTransaction()
+{
+}
+
 void PinnacleTouch::allowSleep(bool isEnabled)
 {
     if (_dataMode <= PINNACLE_ABSOLUTE) {
-        uint8_t temp = 0;
-        rapRead(PINNACLE_SYS_CONFIG, &temp);
-        rapWrite(PINNACLE_SYS_CONFIG, (temp & 0xFB) | (isEnabled << 2));
+        writeFields(AllowSleep::set(isEnabled));
     }
 }
 
@@ -232,8 +416,8 @@ bool PinnacleTouch::isAllowSleep()
 {
     if (_dataMode <= PINNACLE_ABSOLUTE) {
         uint8_t temp = 0;
-        rapRead(PINNACLE_SYS_CONFIG, &temp);
-        return (bool)(temp & 4);
+        cachedRead(SysConfig::address, &temp);
+        return (bool)AllowSleep::get(temp);
     }
     return false;
 }
@@ -241,10 +425,7 @@ bool PinnacleTouch::isAllowSleep()
 void PinnacleTouch::shutdown(bool isOff)
 {
     if (_dataMode <= PINNACLE_ABSOLUTE) {
-        uint8_t temp = 0;
-        rapRead(PINNACLE_SYS_CONFIG, &temp);
-        temp &= 0xFD;
-        rapWrite(PINNACLE_SYS_CONFIG, temp | (isOff << 1));
+        writeFields(Shutdown::set(isOff));
     }
 }
 
@@ -252,8 +433,8 @@ bool PinnacleTouch::isShutdown()
 {
     if (_dataMode <= PINNACLE_ABSOLUTE) {
         uint8_t temp = 0;
-        rapRead(PINNACLE_SYS_CONFIG, &temp);
-        return (bool)(temp & 2);
+        cachedRead(SysConfig::address, &temp);
+        return (bool)Shutdown::get(temp);
     }
     return false;
 }
@@ -263,20 +444,20 @@ void PinnacleTouch::setSampleRate(uint16_t value)
     if (_dataMode == PINNACLE_ABSOLUTE || _dataMode == PINNACLE_RELATIVE) {
         if (!_rev2025 && (value == 200 || value == 300)) {
             // disable palm & noise compensations
-            rapWrite(PINNACLE_FEED_CONFIG_3, 10);
+            cachedWrite(FeedConfig3::address, 10);
             uint8_t reloadTimer = value == 300 ? 6 : 9;
-            eraWriteBytes(0x019E, reloadTimer, 2);
+            eraWriteBytes(ReloadTimer::address, reloadTimer, 2);
             value = 0;
         }
         else {
             // enable palm & noise compensations
-            rapWrite(PINNACLE_FEED_CONFIG_3, 0);
+            cachedWrite(FeedConfig3::address, 0);
             if (!_rev2025) {
-                eraWriteBytes(0x019E, 0x13, 2);
+                eraWriteBytes(ReloadTimer::address, 0x13, 2);
             }
         }
         // bad input values interpreted as 100 by Pinnacle
-        rapWrite(PINNACLE_SAMPLE_RATE, (uint8_t)value);
+        cachedWrite(SampleRate::address, (uint8_t)value);
     }
 }
 
@@ -284,9 +465,9 @@ uint16_t PinnacleTouch::getSampleRate()
 {
     if (_dataMode == PINNACLE_ABSOLUTE || _dataMode == PINNACLE_RELATIVE) {
         uint8_t temp = 0;
-        rapRead(PINNACLE_SAMPLE_RATE, &temp);
+        cachedRead(SampleRate::address, &temp);
         if (!_rev2025 && temp == 0) {
-            eraRead(0x019E, &temp);
+            eraRead(ReloadTimer::address, &temp);
             return temp == 6 ? 300 : 200;
         }
         else if (temp != 10 || temp != 20 || temp != 40 || temp != 60 || temp != 80 || temp != 100) {
@@ -300,11 +481,9 @@ uint16_t PinnacleTouch::getSampleRate()
 void PinnacleTouch::detectFingerStylus(bool enableFinger, bool enableStylus, uint16_t sampleRate)
 {
     if (!_rev2025 && (_dataMode == PINNACLE_ABSOLUTE || _dataMode == PINNACLE_RELATIVE)) {
+        EraSession session(this);
         setSampleRate(sampleRate);
-        uint8_t fingerStylus = 0;
-        eraRead(0x00EB, &fingerStylus);
-        fingerStylus |= (enableStylus << 2) | enableFinger;
-        eraWrite(0x00EB, fingerStylus);
+        writeFields(StylusDetect::set(enableStylus) | FingerDetect::set(enableFinger));
     }
 }
 
@@ -312,8 +491,11 @@ bool PinnacleTouch::calibrate(bool run, bool tap, bool trackError, bool nerd, bo
 {
     PINNACLE_USE_ARDUINO_API
     if (_dataMode == PINNACLE_ABSOLUTE || _dataMode == PINNACLE_RELATIVE) {
-        uint8_t temp = (tap << 4) | (trackError << 3) | (nerd << 2) | (background << 1);
-        rapWrite(PINNACLE_CAL_CONFIG, temp | run);
+        uint8_t temp = (TapComp::set(tap) | TrackErrorComp::set(trackError) | NerdComp::set(nerd) | BackgroundComp::set(background)).value;
+        // always written to (re)trigger calibration
+        rapWrite(CalConfig::address, CalibrateRun::set(run).apply(temp));
+        if (_cacheValid)
+            _cache[CalConfig::address - PINNACLE_CACHE_START] = temp; // run flag self-clears
         if (run) {
             bool done = false;
             uint32_t timeout = millis() + 100;
@@ -329,24 +511,22 @@ bool PinnacleTouch::calibrate(bool run, bool tap, bool trackError, bool nerd, bo
     return false;
 }
 
+// store a compensation matrix in the order of its registers (big endian)
+static void packMatrix(const int16_t* matrix, uint8_t len, uint8_t* buffer)
+{
+    for (uint8_t i = 0; i < 46; i++) {
+        int16_t value = i < len ? matrix[i] : 0; // pads out malformed matrices
+        buffer[i * 2] = (uint8_t)(value >> 8);
+        buffer[i * 2 + 1] = (uint8_t)(value & 0xFF);
+    }
+}
+
 void PinnacleTouch::setCalibrationMatrix(int16_t* matrix, uint8_t len)
 {
     if (!_rev2025 && _dataMode <= PINNACLE_ABSOLUTE) {
-        bool prevFeedState = isFeedEnabled();
-        if (prevFeedState)
-            feedEnabled(false); // this will save time on subsequent eraWrite calls
-
-        for (uint8_t i = 0; i < 46; i++) {
-            if (i < len) {
-                eraWrite(0x01DF + i * 2, (uint8_t)(matrix[i] >> 8));
-                eraWrite(0x01E0 + i * 2, (uint8_t)(matrix[i] & 0xFF));
-            }
-            else // pad out malformed matrices
-                eraWriteBytes(0x01DF + i * 2, 0, 2);
-        }
-
-        if (prevFeedState)
-            feedEnabled(prevFeedState); // resume previous feed state
+        uint8_t buffer[92];
+        packMatrix(matrix, len, buffer);
+        eraWriteBuffer(CalibrationMatrix::address, buffer, 92);
     }
 }
 
@@ -354,7 +534,7 @@ void PinnacleTouch::getCalibrationMatrix(int16_t* matrix)
 {
     if (!_rev2025 && _dataMode <= PINNACLE_ABSOLUTE) {
         // must use sequential read of 92 bytes; individual reads return inaccurate data
-        eraReadBytes(0x01DF, reinterpret_cast<uint8_t*>(matrix), 92);
+        eraReadBytes(CalibrationMatrix::address, reinterpret_cast<uint8_t*>(matrix), 92);
         for (uint8_t i = 0; i < 46; ++i) {
             // reverse the endianess that was read from the registers
             matrix[i] = (matrix[i] << 8) | (matrix[i] >> 8);
@@ -362,22 +542,166 @@ void PinnacleTouch::getCalibrationMatrix(int16_t* matrix)
     }
 }
 
+void PinnacleTouch::getConfigSnapshot(PinnacleConfigSnapshot* snapshot)
+{
+    if (_dataMode <= PINNACLE_ABSOLUTE) {
+        BusSession session(this); // hold the bus for the whole snapshot, as setConfigSnapshot() does
+        // read before the feed is suspended for the extended registers
+        rapReadBytes(PINNACLE_CACHE_START, snapshot->config, PINNACLE_CACHE_SIZE);
+        if (_rev2025) {
+            snapshot->reloadTimer = 0;
+            snapshot->adcConfig = 0;
+            snapshot->xAxisWideZMin = 0;
+            snapshot->yAxisWideZMin = 0;
+            snapshot->fingerStylus = 0;
+            for (uint8_t i = 0; i < 46; ++i)
+                snapshot->calibrationMatrix[i] = 0;
+        }
+        else {
+            EraSession eraSession(this); // suspend the feed once for all extended registers
+            eraRead(ReloadTimer::address, &snapshot->reloadTimer);
+            eraRead(AdcConfig::address, &snapshot->adcConfig);
+            eraRead(XAxisWideZMin::address, &snapshot->xAxisWideZMin);
+            eraRead(YAxisWideZMin::address, &snapshot->yAxisWideZMin);
+            eraRead(FingerStylus::address, &snapshot->fingerStylus);
+            getCalibrationMatrix(snapshot->calibrationMatrix);
+        }
+    }
+}
+
+bool PinnacleTouch::setConfigSnapshot(const PinnacleConfigSnapshot* snapshot, const PinnacleConfigSnapshot* current)
+{
+    if (_dataMode != PINNACLE_RELATIVE && _dataMode != PINNACLE_ABSOLUTE)
+        return false;
+    BusSession session(this);
+    restoreConfig(snapshot, current);
+    return true;
+}
+
+void PinnacleTouch::restoreConfig(const PinnacleConfigSnapshot* snapshot, const PinnacleConfigSnapshot* current)
+{
+    if (!_rev2025) {
+        EraSession eraSession(this); // suspend the feed once for all extended registers
+        if (!current || current->reloadTimer != snapshot->reloadTimer)
+            eraWriteBytes(ReloadTimer::address, snapshot->reloadTimer, 2);
+        if (!current || current->adcConfig != snapshot->adcConfig)
+            eraWrite(AdcConfig::address, snapshot->adcConfig);
+        if (!current || current->xAxisWideZMin != snapshot->xAxisWideZMin)
+            eraWrite(XAxisWideZMin::address, snapshot->xAxisWideZMin);
+        if (!current || current->yAxisWideZMin != snapshot->yAxisWideZMin)
+            eraWrite(YAxisWideZMin::address, snapshot->yAxisWideZMin);
+        if (!current || current->fingerStylus != snapshot->fingerStylus)
+            eraWrite(FingerStylus::address, snapshot->fingerStylus);
+
+        // only write the runs of changed values in the compensation matrix
+        uint8_t matrix[92];
+        packMatrix(snapshot->calibrationMatrix, 46, matrix);
+        for (uint8_t i = 0; i < 46;) {
+            if (current && current->calibrationMatrix[i] == snapshot->calibrationMatrix[i]) {
+                ++i;
+                continue;
+            }
+            uint8_t start = i;
+            while (i < 46 && (!current || current->calibrationMatrix[i] != snapshot->calibrationMatrix[i]))
+                ++i;
+            eraWriteBuffer((uint16_t)(CalibrationMatrix::address + start * 2), matrix + start * 2, (uint8_t)((i - start) * 2));
+        }
+    }
+
+    uint8_t config[PINNACLE_CACHE_SIZE];
+    for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i)
+        config[i] = snapshot->config[i];
+    // a reset, shutdown, or AnyMeas mode is not restored
+    config[0] = (Reset::set(0) | Shutdown::set(0) | AnyMeas::set(0)).apply(config[0]);
+    config[CalConfig::address - PINNACLE_CACHE_START] = CalibrateRun::set(0).apply(config[CalConfig::address - PINNACLE_CACHE_START]);
+
+    // the mirrored values (if any) are the present values; otherwise read them in 1 transaction
+    uint8_t present[PINNACLE_CACHE_SIZE];
+    if (!_cacheValid) {
+        if (current)
+            for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i)
+                present[i] = current->config[i];
+        else
+            rapReadBytes(PINNACLE_CACHE_START, present, PINNACLE_CACHE_SIZE);
+        uint8_t first = 0, last = 0;
+        for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i) {
+            if (config[i] == present[i] && first == i)
+                first = i + 1;
+            if (config[i] != present[i])
+                last = i + 1;
+        }
+        if (first < last)
+            rapWriteBytes(PINNACLE_CACHE_START + first, config + first, last - first);
+    }
+    else
+        cachedWriteBytes(PINNACLE_CACHE_START, config, PINNACLE_CACHE_SIZE);
+
+    _dataMode = AbsoluteMode::get(config[FeedConfig1::address - PINNACLE_CACHE_START]) ? PINNACLE_ABSOLUTE : PINNACLE_RELATIVE;
+    if (_dataMode == PINNACLE_RELATIVE && Intellimouse::get(config[FeedConfig2::address - PINNACLE_CACHE_START])) {
+        if (!_intellimouse)
+            enableIntellimouse();
+    }
+    else
+        _intellimouse = false;
+}
+
+// version, configuration registers, 5 extended registers, compensation matrix, checksum
+static_assert(1 + PINNACLE_CACHE_SIZE + 5 + 92 + 1 == PINNACLE_CONFIG_BLOB_SIZE, "unexpected blob layout");
+
+void PinnacleConfigSnapshot::serialize(uint8_t* blob) const
+{
+    blob[0] = PINNACLE_CONFIG_BLOB_VERSION;
+    for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i)
+        blob[1 + i] = config[i];
+    uint8_t* era = blob + 1 + PINNACLE_CACHE_SIZE;
+    era[0] = reloadTimer;
+    era[1] = adcConfig;
+    era[2] = xAxisWideZMin;
+    era[3] = yAxisWideZMin;
+    era[4] = fingerStylus;
+    packMatrix(calibrationMatrix, 46, era + 5);
+    // the checksum makes the sum of all bytes 0
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < PINNACLE_CONFIG_BLOB_SIZE - 1; ++i)
+        sum += blob[i];
+    blob[PINNACLE_CONFIG_BLOB_SIZE - 1] = (uint8_t)(0x100 - sum);
+}
+
+bool PinnacleConfigSnapshot::deserialize(const uint8_t* blob)
+{
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < PINNACLE_CONFIG_BLOB_SIZE; ++i)
+        sum += blob[i];
+    if (blob[0] != PINNACLE_CONFIG_BLOB_VERSION || sum)
+        return false;
+    for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i)
+        config[i] = blob[1 + i];
+    const uint8_t* era = blob + 1 + PINNACLE_CACHE_SIZE;
+    reloadTimer = era[0];
+    adcConfig = era[1];
+    xAxisWideZMin = era[2];
+    yAxisWideZMin = era[3];
+    fingerStylus = era[4];
+    for (uint8_t i = 0; i < 46; ++i)
+        calibrationMatrix[i] = (int16_t)((era[5 + i * 2] << 8) | era[6 + i * 2]);
+    return true;
+}
+
 void PinnacleTouch::setAdcGain(uint8_t sensitivity)
 {
     if (!_rev2025 && _dataMode <= PINNACLE_ABSOLUTE) {
         if (sensitivity >= 4)
             sensitivity = 0; // faulty input defaults to highest sensitivity
-        uint8_t temp = 0;
-        eraRead(0x0187, &temp);
-        eraWrite(0x0187, (temp & 0x3F) | (sensitivity << 6));
+        writeFields(AdcGain::set(sensitivity));
     }
 }
 
 void PinnacleTouch::tuneEdgeSensitivity(uint8_t xAxisWideZMin, uint8_t yAxisWideZMin)
 {
     if (!_rev2025 && _dataMode <= PINNACLE_ABSOLUTE) {
-        eraWrite(0x0149, xAxisWideZMin);
-        eraWrite(0x0168, yAxisWideZMin);
+        EraSession session(this);
+        eraWrite(XAxisWideZMin::address, xAxisWideZMin);
+        eraWrite(YAxisWideZMin::address, yAxisWideZMin);
     }
 }
 
@@ -386,19 +710,23 @@ void PinnacleTouch::tuneEdgeSensitivity(uint8_t xAxisWideZMin, uint8_t yAxisWide
 void PinnacleTouch::anymeasModeConfig(uint8_t gain, uint8_t frequency, uint32_t sampleLength, uint8_t muxControl, uint32_t apertureWidth, uint8_t controlPowerCount)
 {
     if (_dataMode == PINNACLE_ANYMEAS) {
+        uint8_t zeros[8] = {0};
         uint8_t buffer[10] = {0};
-        rapWriteBytes(PINNACLE_PACKET_BYTE_1, buffer, 8); // zero out toggle/polarity registers
-
         buffer[0] = gain | frequency;
         sampleLength /= 128;
         buffer[1] = (uint8_t)(sampleLength < 1 ? 1 : (sampleLength > 3 ? 3 : sampleLength));
         buffer[2] = muxControl;
         apertureWidth /= 125;
         buffer[4] = (uint8_t)(apertureWidth < 2 ? 2 : (apertureWidth > 15 ? 15 : apertureWidth));
-        buffer[6] = PINNACLE_PACKET_BYTE_1;
+        buffer[6] = PacketByte1::address;
         buffer[9] = controlPowerCount;
-        rapWriteBytes(PINNACLE_FEED_CONFIG_2, buffer, 10);
-        clearStatusFlags();
+        RapOperation setup[] = {
+            {PacketByte1::address, zeros, 8, false}, // zero out toggle/polarity registers
+            {FeedConfig2::address, buffer, 10, false},
+            {Status::address, zeros, 1, false}, // clear Status flags
+        };
+        cachedSubmit(setup, 3);
+        statusCleared();
     }
 }
 
@@ -421,10 +749,10 @@ void PinnacleTouch::startMeasureAdc(unsigned int bitsToToggle, unsigned int togg
             buffer[3 - i] = (uint8_t)(bitsToToggle >> (i * 8));
             buffer[3 - i + 4] = (uint8_t)(togglePolarity >> (i * 8));
         }
-        rapWriteBytes(PINNACLE_PACKET_BYTE_1, buffer, 8);
+        rapWriteBytes(PacketByte1::address, buffer, 8);
         buffer[0] = 0;    // clearStatusFlags()
         buffer[1] = 0x18; // initiate measurements
-        rapWriteBytes(PINNACLE_STATUS, buffer, 2);
+        rapWriteBytes(Status::address, buffer, 2);
     }
 }
 
@@ -433,8 +761,8 @@ int16_t PinnacleTouch::getMeasureAdc()
     // user code should only call this when Data Ready pin has asserted after calling startMeasureAdc()
     if (_dataMode == PINNACLE_ANYMEAS) {
         uint16_t buffer = 0;
-        rapReadBytes(PINNACLE_PACKET_BYTE_0 - 1, reinterpret_cast<uint8_t*>(&buffer), 2);
-        clearStatusFlags();
+        rapReadPacket(PacketByte0::address - 1, reinterpret_cast<uint8_t*>(&buffer), 2);
+        statusCleared();
         return (int16_t)((buffer << 8) | (buffer >> 8));
     }
     return 0;
@@ -442,264 +770,649 @@ int16_t PinnacleTouch::getMeasureAdc()
 
 #endif // PINNACLE_ANYMEAS_SUPPORT == true
 
-void PinnacleTouch::eraWrite(uint16_t registerAddress, uint8_t registerValue)
+void PinnacleTouch::eraPrepare()
 {
-    bool prevFeedState = isFeedEnabled();
-    if (prevFeedState) {
-        feedEnabled(false); // accessing raw memory, so do this
-    }
 #ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-    PINNACLE_USE_ARDUINO_API
     if (_rev2025) {
         clearStatusFlags();
     }
 #endif
-    rapWrite(PINNACLE_ERA_VALUE, registerValue);
-    uint8_t buffer[2] = {(uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF)};
-    rapWriteBytes(PINNACLE_ERA_ADDR, buffer, 2);
-    rapWrite(PINNACLE_ERA_CONTROL, 2); // indicate writing only 1 byte
+}
+
+void PinnacleTouch::eraStart(uint16_t registerAddress, uint8_t control)
+{
+    // ERA_ADDR (2 bytes) and ERA_CONTROL are consecutive registers
+    uint8_t buffer[3] = {(uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF), control};
+    rapWriteBytes(EraAddr::address, buffer, 3);
+}
+
+void PinnacleTouch::eraStartWrite(uint16_t registerAddress, uint8_t registerValue, uint8_t control)
+{
+    // ERA_VALUE, ERA_ADDR (2 bytes), and ERA_CONTROL are consecutive registers
+    uint8_t buffer[4] = {registerValue, (uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF), control};
+    rapWriteBytes(EraValue::address, buffer, 4);
+}
+
+bool PinnacleTouch::eraBusy()
+{
 #ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-    if (!_rev2025) {
+    if (_rev2025) {
+        return !available();
+    }
 #endif
-        do {
-            rapRead(PINNACLE_ERA_CONTROL, buffer); // read until register value == 0
-        } while (buffer[0]);
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
+    uint8_t control = 0;
+    rapRead(EraControl::address, &control); // register value == 0 when done
+    return control;
+}
+
+void PinnacleTouch::eraWait()
+{
+    while (eraBusy()) {
     }
-    else {
-        while (!digitalRead(_dataReady))
-        {
-        }
+}
+
+void PinnacleTouch::eraSuspendFeed()
+{
+    if (_eraDepth++ == 0) {
+        _eraFeedState = isFeedEnabled();
+        if (_eraFeedState)
+            feedEnabled(false);
     }
-#endif
+}
+
+void PinnacleTouch::eraResumeFeed()
+{
+    if (--_eraDepth == 0 && _eraFeedState)
+        feedEnabled(true); // resume previous feed state
+}
+
+void PinnacleTouch::eraWrite(uint16_t registerAddress, uint8_t registerValue)
+{
+    EraSession session(this); // accessing raw memory, so disable feed
+    eraPrepare();
+    eraStartWrite(registerAddress, registerValue, 2); // indicate writing only 1 byte
+    eraWait();
     clearStatusFlags(); // clear Command Complete flag in Status register
-    if (prevFeedState) {
-        feedEnabled(prevFeedState); // resume previous feed state
-    }
 }
 
 void PinnacleTouch::eraWriteBytes(uint16_t registerAddress, uint8_t registerValue, uint8_t repeat)
 {
     // NOTE this is rarely used as it only writes 1 value to multiple registers
-    bool prevFeedState = isFeedEnabled();
-    if (prevFeedState) {
-        feedEnabled(false); // accessing raw memory, so do this
-    }
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-    PINNACLE_USE_ARDUINO_API
-    if (_rev2025) {
-        clearStatusFlags();
-    }
-#endif
-    rapWrite(PINNACLE_ERA_VALUE, registerValue);
-    uint8_t buffer[2] = {(uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF)};
-    rapWriteBytes(PINNACLE_ERA_ADDR, buffer, 2);
-    rapWrite(PINNACLE_ERA_CONTROL, 0x0A); // indicate writing sequential bytes
+    EraSession session(this); // accessing raw memory, so disable feed
+    eraPrepare();
+    eraStartWrite(registerAddress, registerValue, 0x0A); // indicate writing sequential bytes
     for (uint8_t i = 0; i < repeat; i++) {
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-        if (!_rev2025) {
-#endif
-            do {
-                rapRead(PINNACLE_ERA_CONTROL, buffer); // read until register value == 0
-            } while (buffer[0]);
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-        }
-        else {
-            while (!digitalRead(_dataReady))
-            {
-            }
-        }
-#endif
+        eraWait();
         clearStatusFlags(); // clear Command Complete flag in Status register
     }
-    if (prevFeedState) {
-        feedEnabled(prevFeedState); // resume previous feed state
+}
+
+void PinnacleTouch::eraWriteBuffer(uint16_t registerAddress, uint8_t* registerValues, uint8_t registerCount)
+{
+    EraSession session(this); // accessing raw memory, so disable feed
+    eraPrepare();
+    // the address is only set once; the Pinnacle ASIC increments it after each write
+    uint8_t buffer[2] = {(uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF)};
+    rapWriteBytes(EraAddr::address, buffer, 2);
+    for (uint8_t i = 0; i < registerCount; ++i) {
+        rapWrite(EraValue::address, registerValues[i]);
+        rapWrite(EraControl::address, 0x0A); // indicate writing sequential bytes
+        eraWait();
+        clearStatusFlags(); // clear Command Complete flag in Status register
     }
 }
 
 void PinnacleTouch::eraRead(uint16_t registerAddress, uint8_t* data)
 {
-    bool prevFeedState = isFeedEnabled();
-    if (prevFeedState) {
-        feedEnabled(false); // accessing raw memory, so do this
-    }
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-    PINNACLE_USE_ARDUINO_API
-    if (_rev2025) {
-        clearStatusFlags();
-    }
-#endif
+    EraSession session(this); // accessing raw memory, so disable feed
+    eraPrepare();
+    eraStart(registerAddress, 1); // indicate reading only 1 byte
+    eraWait();
+    rapRead(EraValue::address, data); // get data
+    clearStatusFlags();                // clear Command Complete flag in Status register
+}
+
+void PinnacleTouch::eraReadBytes(uint16_t registerAddress, uint8_t* data, uint8_t registerCount)
+{
+    EraSession session(this); // accessing raw memory, so disable feed
+    eraPrepare();
     uint8_t buffer[2] = {(uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF)};
-    rapWriteBytes(PINNACLE_ERA_ADDR, buffer, 2);
-    rapWrite(PINNACLE_ERA_CONTROL, 1); // indicate reading only 1 byte
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-    if (!_rev2025) {
-#endif
-        do {
-            rapRead(PINNACLE_ERA_CONTROL, buffer); // read until register value == 0
-        } while (buffer[0]);
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
+    rapWriteBytes(EraAddr::address, buffer, 2);
+    for (uint8_t i = 0; i < registerCount; ++i) {
+        rapWrite(EraControl::address, 5); // indicate reading sequential bytes
+        eraWait();
+        rapRead(EraValue::address, data + i); // get value
+        clearStatusFlags();                    // clear Command Complete flag in Status register
     }
-    else {
-        while (!digitalRead(_dataReady))
+}
+
+bool PinnacleTouch::eraQueueWrite(uint16_t registerAddress, uint8_t registerValue)
+{
+    if (_dataMode == PINNACLE_ERROR || _eraQueueCount >= PINNACLE_ERA_QUEUE_SIZE)
+        return false;
+    EraOperation& op = _eraQueue[(_eraQueueHead + _eraQueueCount++) % PINNACLE_ERA_QUEUE_SIZE];
+    op.address = registerAddress;
+    op.value = registerValue;
+    op.data = nullptr;
+    return true;
+}
+
+bool PinnacleTouch::eraQueueRead(uint16_t registerAddress, uint8_t* data)
+{
+    // a null `data` marks a write operation in the queue
+    if (data == nullptr || _dataMode == PINNACLE_ERROR || _eraQueueCount >= PINNACLE_ERA_QUEUE_SIZE)
+        return false;
+    EraOperation& op = _eraQueue[(_eraQueueHead + _eraQueueCount++) % PINNACLE_ERA_QUEUE_SIZE];
+    op.address = registerAddress;
+    op.data = data;
+    return true;
+}
+
+PinnacleEraStatus PinnacleTouch::eraPoll()
+{
+    if (!_eraQueueCount)
+        return PINNACLE_ERA_IDLE;
+    // Each blocking ERA operation (or EraSession) suspends the feed once more than the queue
+    // does. The queue waits until they finish, so their register accesses are not interleaved.
+    if (_eraDepth > (_eraQueueHeld ? 1 : 0))
+        return PINNACLE_ERA_BUSY;
+    // drops the queue if the bus driver throws (an interrupted operation can't be resumed)
+    struct DropOnError
+    {
+        PinnacleTouch* touch;
+        ~DropOnError()
         {
+            if (touch)
+                touch->eraQueueClear();
+        }
+    } dropOnError = {this};
+    BusSession session(this);
+    PinnacleEraStatus status = PINNACLE_ERA_BUSY;
+    EraOperation& op = _eraQueue[_eraQueueHead];
+    if (!_eraQueueActive) { // start the next operation
+        if (!_eraQueueHeld) {
+            // marked first, so eraQueueClear() releases the hold if suspending the feed throws
+            _eraQueueHeld = true;
+            eraSuspendFeed(); // held until the queue is finished
         }
+        eraPrepare();
+        if (op.data == nullptr) {
+            eraStartWrite(op.address, op.value, 2); // indicate writing only 1 byte
+        }
+        else
+            eraStart(op.address, 1); // indicate reading only 1 byte
+        _eraQueueActive = true;
     }
-#endif
-    rapRead(PINNACLE_ERA_VALUE, data); // get data
-    clearStatusFlags();                // clear Command Complete flag in Status register
-    if (prevFeedState) {
-        feedEnabled(prevFeedState); // resume previous feed state
+    else if (!eraBusy()) {
+        if (op.data != nullptr)
+            rapRead(EraValue::address, op.data); // get data
+        clearStatusFlags();                        // clear Command Complete flag in Status register
+        _eraQueueActive = false;
+        _eraQueueHead = (_eraQueueHead + 1) % PINNACLE_ERA_QUEUE_SIZE;
+        if (--_eraQueueCount == 0) {
+            _eraQueueHeld = false;
+            eraResumeFeed();
+            status = PINNACLE_ERA_COMPLETE;
+        }
     }
+    dropOnError.touch = nullptr;
+    return status;
 }
 
-void PinnacleTouch::eraReadBytes(uint16_t registerAddress, uint8_t* data, uint8_t registerCount)
+void PinnacleTouch::eraQueueClear()
 {
-    bool prevFeedState = isFeedEnabled();
-    if (prevFeedState) {
-        feedEnabled(false); // accessing raw memory, so do this
+    if (_eraQueueHeld && _eraDepth)
+        --_eraDepth; // release the queue's hold on the feed without any bus access
+    _eraQueueHead = 0;
+    _eraQueueCount = 0;
+    _eraQueueActive = false;
+    _eraQueueHeld = false;
+}
+
+uint8_t PinnacleTouch::eraPending()
+{
+    return _eraQueueCount;
+}
+
+void PinnacleTouch::syncCache()
+{
+    rapReadBytes(PINNACLE_CACHE_START, _cache, PINNACLE_CACHE_SIZE);
+    _cacheValid = true;
+}
+
+void PinnacleTouch::cachedRead(uint8_t registerAddress, uint8_t* data)
+{
+    uint8_t index = registerAddress - PINNACLE_CACHE_START; // wraps around if below range
+    if (_cacheEnabled && index < PINNACLE_CACHE_SIZE) {
+        if (!_cacheValid)
+            syncCache();
+        *data = _cache[index];
     }
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-    PINNACLE_USE_ARDUINO_API
-    if (_rev2025) {
-        clearStatusFlags();
+    else
+        rapRead(registerAddress, data);
+}
+
+void PinnacleTouch::cachedWrite(uint8_t registerAddress, uint8_t registerValue)
+{
+    uint8_t index = registerAddress - PINNACLE_CACHE_START; // wraps around if below range
+    if (_cacheValid && index < PINNACLE_CACHE_SIZE) {
+        if (_cache[index] == registerValue)
+            return; // nothing changed
+        _cache[index] = registerValue;
     }
-#endif
-    uint8_t buffer[2] = {(uint8_t)(registerAddress >> 8), (uint8_t)(registerAddress & 0xFF)};
-    rapWriteBytes(PINNACLE_ERA_ADDR, buffer, 2);
-    for (uint8_t i = 0; i < registerCount; ++i) {
-        rapWrite(PINNACLE_ERA_CONTROL, 5); // indicate reading sequential bytes
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-        if (!_rev2025) {
-#endif
-            do {
-                rapRead(PINNACLE_ERA_CONTROL, buffer); // read until register value == 0
-            } while (buffer[0]);
-#ifdef PINNACLE_EXPERIMENTAL_ERA_2025_FIRMWARE
-        }
-        else {
-            while (!digitalRead(_dataReady))
-            {
-            }
+    rapWrite(registerAddress, registerValue);
+}
+
+void PinnacleTouch::cachedWriteBytes(uint8_t registerAddress, uint8_t* registerValues, uint8_t registerCount)
+{
+    RapOperation operation = {registerAddress, registerValues, registerCount, false};
+    if (_cacheValid && !cacheTrim(operation))
+        return; // nothing changed
+    rapWriteBytes(operation.address, operation.data, operation.count);
+}
+
+void PinnacleTouch::cachedSubmit(RapOperation* operations, uint8_t count)
+{
+    // drop the write operations that don't change any mirrored values
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (operations[i].read || !_cacheValid || cacheTrim(operations[i]))
+            operations[kept++] = operations[i];
+    }
+    if (kept)
+        rapSubmit(operations, kept);
+}
+
+bool PinnacleTouch::cacheTrim(RapOperation& operation)
+{
+    // trim the leading and trailing registers whose mirrored values are unchanged
+    uint8_t first = 0, last = 0;
+    for (uint8_t i = 0; i < operation.count; ++i) {
+        uint8_t index = operation.address + i - PINNACLE_CACHE_START;
+        bool unchanged = index < PINNACLE_CACHE_SIZE && _cache[index] == operation.data[i];
+        if (unchanged && first == i)
+            first = i + 1;
+        if (!unchanged)
+            last = i + 1;
+        if (index < PINNACLE_CACHE_SIZE)
+            _cache[index] = operation.data[i];
+    }
+    if (first >= last)
+        return false;
+    operation.address += first;
+    operation.data += first;
+    operation.count = last - first;
+    return true;
+}
+
+template <class Register>
+void PinnacleTouch::writeFields(PinnacleRegisterUpdate<Register> update)
+{
+    if (Register::access == PINNACLE_ERA_ACCESS) {
+        if (update.isWhole()) {
+            eraWrite(Register::address, update.value);
+            return;
         }
-#endif
-        rapRead(PINNACLE_ERA_VALUE, data + i); // get value
-        clearStatusFlags();                    // clear Command Complete flag in Status register
+        EraSession session(this); // suspend the feed once for both operations
+        uint8_t temp = 0;
+        eraRead(Register::address, &temp);
+        eraWrite(Register::address, update.apply(temp));
     }
-    if (prevFeedState) {
-        feedEnabled(prevFeedState); // resume previous feed state
+    else {
+        uint8_t temp = 0;
+        if (!update.isWhole())
+            cachedRead(static_cast<uint8_t>(Register::address), &temp);
+        cachedWrite(static_cast<uint8_t>(Register::address), update.apply(temp));
     }
 }
 
+PinnacleTouch::EraSession::EraSession(PinnacleTouch* touch) : _touch(touch)
+{
+    _touch->eraSuspendFeed();
+}
+
+PinnacleTouch::EraSession::~EraSession()
+{
+    _touch->eraResumeFeed();
+}
+
+PinnacleTouch::BusSession::BusSession(PinnacleTouch* touch) : _touch(touch)
+{
+#ifdef PINNACLE_BUS_LOCK
+    _touch->lockBus(); // also protects _busDepth
+#endif
+    if (_touch->_busDepth++ == 0)
+        _touch->beginBusTransaction();
+}
+
+PinnacleTouch::BusSession::~BusSession()
+{
+    if (--_touch->_busDepth == 0)
+        _touch->endBusTransaction();
+#ifdef PINNACLE_BUS_LOCK
+    _touch->unlockBus();
+#endif
+}
+
 PinnacleTouchSPI::PinnacleTouchSPI(pinnacle_gpio_t dataReadyPin, pinnacle_gpio_t slaveSelectPin, uint32_t spiSpeed)
-    : PinnacleTouch(dataReadyPin), _slaveSelect(slaveSelectPin), _spiSpeed(spiSpeed)
+    : PinnacleTouchStatic(dataReadyPin), _slaveSelect(slaveSelectPin), _spiSpeed(spiSpeed)
 {
 }
 
 bool PinnacleTouchSPI::begin(pinnacle_spi_t* spi_bus)
 {
-    PINNACLE_USE_ARDUINO_API
-    spi = spi_bus;
-#ifndef PINNACLE_USE_NATIVE_CS
-    pinMode(_slaveSelect, OUTPUT);
-    PINNACLE_SS_CTRL(_slaveSelect, HIGH);
-#endif
+    useBus(spi_bus);
     return PinnacleTouch::begin();
 }
 
 bool PinnacleTouchSPI::begin()
+{
+    return PinnacleTouchSPI::begin(startBus());
+}
+
+bool PinnacleTouchSPI::fastBegin(pinnacle_spi_t* spi_bus, const PinnacleConfigSnapshot* snapshot)
+{
+    useBus(spi_bus);
+    return PinnacleTouch::fastBegin(snapshot);
+}
+
+bool PinnacleTouchSPI::fastBegin(const PinnacleConfigSnapshot* snapshot)
+{
+    return PinnacleTouchSPI::fastBegin(startBus(), snapshot);
+}
+
+pinnacle_spi_t* PinnacleTouchSPI::startBus()
 {
     PINNACLE_USE_ARDUINO_API
-    SPI.begin(
 #ifdef PINNACLE_USE_NATIVE_CS // (mainly Linux drivers)
-        _slaveSelect          // SS_PIN is not an actual GPIO pin -> /dev/spidevX.Y
+    // SS_PIN is not an actual GPIO pin -> /dev/spidevX.Y; each device gets its own bus object
+    _spiDevice.begin(
+        _slaveSelect
     #ifndef SPI_HAS_TRANSACTION
         , // include SPI speed if begin/endTransaction() aren't implemented
         SPISettings(_spiSpeed, MSBFIRST, SPI_MODE1)
     #endif
-#endif // ifdef PINNACLE_USE_NATIVE_CS
     );
-    return PinnacleTouchSPI::begin(&SPI);
+    return &_spiDevice;
+#else
+    SPI.begin();
+    return &SPI;
+#endif // ifdef PINNACLE_USE_NATIVE_CS
 }
 
-void PinnacleTouchSPI::rapWriteCmd(uint8_t* sequence, uint8_t len)
+void PinnacleTouchSPI::useBus(pinnacle_spi_t* spi_bus)
 {
     PINNACLE_USE_ARDUINO_API
-#ifdef SPI_HAS_TRANSACTION
-    spi->beginTransaction(SPISettings(_spiSpeed, MSBFIRST, SPI_MODE1));
+    spi = spi_bus;
+#ifndef PINNACLE_USE_NATIVE_CS
+    pinMode(_slaveSelect, OUTPUT);
+    PINNACLE_SS_CTRL(_slaveSelect, HIGH);
 #endif
+}
+
+void PinnacleTouchSPI::rapWriteCmd(uint8_t* sequence, uint8_t len)
+{
+    BusSession session(this);
+    PINNACLE_USE_ARDUINO_API
     PINNACLE_SS_CTRL(_slaveSelect, LOW);
     spi->transfer(sequence, len);
     PINNACLE_SS_CTRL(_slaveSelect, HIGH);
-#ifdef SPI_HAS_TRANSACTION
-    spi->endTransaction();
-#endif
 }
 
 void PinnacleTouchSPI::rapWrite(uint8_t registerAddress, uint8_t registerValue)
 {
+    BusSession session(this);
     PINNACLE_USE_ARDUINO_API
-#ifdef SPI_HAS_TRANSACTION
-    spi->beginTransaction(SPISettings(_spiSpeed, MSBFIRST, SPI_MODE1));
-#endif
     PINNACLE_SS_CTRL(_slaveSelect, LOW);
 #ifdef PINNACLE_SPI_BUFFER_OPS
-    uint8_t* buf = (uint8_t*)malloc(2);
-    buf[0] = (uint8_t)(0x80 | registerAddress);
-    buf[1] = registerValue;
-    spi->transfer(buf, 2);
-    free(buf);
+    _buffer[0] = (uint8_t)(0x80 | registerAddress);
+    _buffer[1] = registerValue;
+    spi->transfer(_buffer, 2);
 #else  // !defined(PINNACLE_SPI_BUFFER_OPS)
     spi->transfer((uint8_t)(0x80 | registerAddress));
     spi->transfer(registerValue);
 #endif // !defined(PINNACLE_SPI_BUFFER_OPS)
     PINNACLE_SS_CTRL(_slaveSelect, HIGH);
-#ifdef SPI_HAS_TRANSACTION
-    spi->endTransaction();
-#endif
 }
 
 void PinnacleTouchSPI::rapWriteBytes(uint8_t registerAddress, uint8_t* registerValues, uint8_t registerCount)
 {
+    BusSession session(this);
+#if PINNACLE_SPI_BURST_WRITES
+    PINNACLE_USE_ARDUINO_API
+    PINNACLE_SS_CTRL(_slaveSelect, LOW);
+    #ifdef PINNACLE_SPI_BUFFER_OPS
+    uint8_t i = 0;
+    while (i < registerCount) {
+        uint8_t bufSize = 0;
+        while (i < registerCount && bufSize + 2 <= PINNACLE_SPI_BUFFER_SIZE) {
+            _buffer[bufSize++] = (uint8_t)(0x80 | (registerAddress + i));
+            _buffer[bufSize++] = registerValues[i++];
+        }
+        spi->transfer(_buffer, bufSize);
+    }
+    #else  // !defined(PINNACLE_SPI_BUFFER_OPS)
+    for (uint8_t i = 0; i < registerCount; ++i) {
+        spi->transfer((uint8_t)(0x80 | (registerAddress + i)));
+        spi->transfer(registerValues[i]);
+    }
+    #endif // !defined(PINNACLE_SPI_BUFFER_OPS)
+    PINNACLE_SS_CTRL(_slaveSelect, HIGH);
+#else  // !PINNACLE_SPI_BURST_WRITES
     for (uint8_t i = 0; i < registerCount; ++i)
         rapWrite(registerAddress + i, registerValues[i]);
+#endif // !PINNACLE_SPI_BURST_WRITES
 }
 
 void PinnacleTouchSPI::rapRead(uint8_t registerAddress, uint8_t* data)
 {
+    BusSession session(this);
     rapReadBytes(registerAddress, data, 1);
 }
 
 void PinnacleTouchSPI::rapReadBytes(uint8_t registerAddress, uint8_t* data, uint8_t registerCount)
 {
+    BusSession session(this);
     PINNACLE_USE_ARDUINO_API
-#ifdef SPI_HAS_TRANSACTION
-    spi->beginTransaction(SPISettings(_spiSpeed, MSBFIRST, SPI_MODE1));
-#endif
-    PINNACLE_SS_CTRL(_slaveSelect, LOW);
 #ifdef PINNACLE_SPI_BUFFER_OPS
-    uint8_t bufSize = 3 + registerCount;
-    uint8_t* buf = (uint8_t*)malloc(bufSize);
-    memset(buf, 0xFC, bufSize);
-    buf[0] = 0xA0 | registerAddress;
-    spi->transfer(buf, bufSize);
-    memcpy(data, buf + 3, registerCount);
-    free(buf);
+    // read in chunks that fit in the buffer (each chunk starts a new read command)
+    while (registerCount) {
+        uint8_t count = registerCount;
+        if (count > PINNACLE_SPI_BUFFER_SIZE - 3)
+            count = PINNACLE_SPI_BUFFER_SIZE - 3;
+        PINNACLE_SS_CTRL(_slaveSelect, LOW);
+        memset(_buffer, 0xFC, 3 + count);
+        _buffer[0] = 0xA0 | registerAddress;
+        spi->transfer(_buffer, 3 + count);
+        memcpy(data, _buffer + 3, count);
+        PINNACLE_SS_CTRL(_slaveSelect, HIGH);
+        registerAddress += count;
+        data += count;
+        registerCount -= count;
+    }
 #else  // !defined(PINNACLE_SPI_BUFFER_OPS)
+    PINNACLE_SS_CTRL(_slaveSelect, LOW);
     spi->transfer(0xA0 | registerAddress);
     spi->transfer(0xFC);
     spi->transfer(0xFC);
     for (uint8_t i = 0; i < registerCount; ++i)
         data[i] = spi->transfer(0xFC);
+    PINNACLE_SS_CTRL(_slaveSelect, HIGH);
 #endif // !defined(PINNACLE_SPI_BUFFER_OPS)
+}
+
+void PinnacleTouchSPI::rapReadPacket(uint8_t registerAddress, uint8_t* data, uint8_t registerCount)
+{
+    BusSession session(this);
+#ifdef PINNACLE_SPI_QUEUED_OPS
+    // both CS frames are sent with 1 system call
+    uint8_t bufSize = 3 + registerCount; // largest packet is 6 bytes (absolute mode)
+    memset(_buffer, 0xFC, bufSize);
+    _buffer[0] = 0xA0 | registerAddress;
+    uint8_t* clear = _buffer + bufSize;
+    clear[0] = 0x80 | Status::address;
+    clear[1] = 0;
+    spi->queueTransfer(_buffer, _buffer, bufSize);
+    spi->queueTransfer(clear, clear, 2);
+    spi->flush();
+    memcpy(data, _buffer + 3, registerCount);
+#else // !defined(PINNACLE_SPI_QUEUED_OPS)
+    PINNACLE_USE_ARDUINO_API
+    PINNACLE_SS_CTRL(_slaveSelect, LOW);
+    #ifdef PINNACLE_SPI_BUFFER_OPS
+    uint8_t bufSize = 3 + registerCount; // largest packet is 6 bytes (absolute mode)
+    memset(_buffer, 0xFC, bufSize);
+    _buffer[0] = 0xA0 | registerAddress;
+    spi->transfer(_buffer, bufSize);
+    memcpy(data, _buffer + 3, registerCount);
+    #else  // !defined(PINNACLE_SPI_BUFFER_OPS)
+    spi->transfer(0xA0 | registerAddress);
+    spi->transfer(0xFC);
+    spi->transfer(0xFC);
+    for (uint8_t i = 0; i < registerCount; ++i)
+        data[i] = spi->transfer(0xFC);
+    #endif // !defined(PINNACLE_SPI_BUFFER_OPS)
     PINNACLE_SS_CTRL(_slaveSelect, HIGH);
+    // clear the Status register without releasing the bus in between
+    PINNACLE_SS_CTRL(_slaveSelect, LOW);
+    #ifdef PINNACLE_SPI_BUFFER_OPS
+    _buffer[0] = 0x80 | Status::address;
+    _buffer[1] = 0;
+    spi->transfer(_buffer, 2);
+    #else  // !defined(PINNACLE_SPI_BUFFER_OPS)
+    spi->transfer(0x80 | Status::address);
+    spi->transfer(0);
+    #endif // !defined(PINNACLE_SPI_BUFFER_OPS)
+    PINNACLE_SS_CTRL(_slaveSelect, HIGH);
+#endif // !defined(PINNACLE_SPI_QUEUED_OPS)
+}
+
+void PinnacleTouchSPI::rapSubmit(const RapOperation* operations, uint8_t count)
+{
+    BusSession session(this);
+#ifdef PINNACLE_SPI_QUEUED_OPS
+    // CS frames are queued from _buffer and sent with as few system calls as possible. The
+    // queue is flushed explicitly before it overflows, so each flush() sends all queued frames
+    // in 1 system call (even with 1 register per CS frame).
+    static_assert(PINNACLE_SPI_QUEUE_SIZE >= 2, "A read needs 2 queued transfers (pending writes and the read)");
+    uint8_t used = 0;   // bytes of _buffer that hold queued frames
+    uint8_t frame = 0;  // where the (unqueued) frame of write operations starts
+    uint8_t queued = 0; // number of transfers queued since the last flush
+    for (uint8_t i = 0; i < count; ++i) {
+        const RapOperation& op = operations[i];
+        if (op.read) {
+            if (used > frame) {
+                spi->queueTransfer(_buffer + frame, _buffer + frame, used - frame);
+                ++queued;
+            }
+            if (queued >= PINNACLE_SPI_QUEUE_SIZE || used + 3 + op.count > PINNACLE_SPI_BUFFER_SIZE) {
+                spi->flush(); // make room for the read
+                used = 0;
+            }
+            if (3 + op.count <= PINNACLE_SPI_BUFFER_SIZE) {
+                uint8_t* rx = _buffer + used;
+                memset(rx, 0xFC, 3 + op.count);
+                rx[0] = 0xA0 | op.address;
+                spi->queueTransfer(rx, rx, 3 + op.count);
+                spi->flush();
+                memcpy(op.data, rx + 3, op.count);
+            }
+            else // too big for the buffer
+                rapReadBytes(op.address, op.data, op.count);
+            used = frame = queued = 0;
+            continue;
+        }
+        for (uint8_t j = 0; j < op.count; ++j) {
+            if (used + 2 > PINNACLE_SPI_BUFFER_SIZE || queued >= PINNACLE_SPI_QUEUE_SIZE) { // buffer or queue is full
+                if (used > frame)
+                    spi->queueTransfer(_buffer + frame, _buffer + frame, used - frame);
+                spi->flush();
+                used = frame = queued = 0;
+            }
+            _buffer[used++] = (uint8_t)(0x80 | (op.address + j));
+            _buffer[used++] = op.data[j];
+    #if !PINNACLE_SPI_BURST_WRITES
+            spi->queueTransfer(_buffer + frame, _buffer + frame, 2); // 1 register per CS frame
+            ++queued;
+            frame = used;
+    #endif
+        }
+    }
+    if (used > frame)
+        spi->queueTransfer(_buffer + frame, _buffer + frame, used - frame);
+    spi->flush();
+#elif PINNACLE_SPI_BURST_WRITES
+    PINNACLE_USE_ARDUINO_API
+    uint8_t i = 0;
+    while (i < count) {
+        if (operations[i].read) {
+            rapReadBytes(operations[i].address, operations[i].data, operations[i].count);
+            ++i;
+            continue;
+        }
+        // adjacent write operations are sent as address/value pairs in 1 CS frame
+        PINNACLE_SS_CTRL(_slaveSelect, LOW);
+    #ifdef PINNACLE_SPI_BUFFER_OPS
+        uint8_t bufSize = 0;
+    #endif
+        for (; i < count && !operations[i].read; ++i) {
+            for (uint8_t j = 0; j < operations[i].count; ++j) {
+    #ifdef PINNACLE_SPI_BUFFER_OPS
+                if (bufSize + 2 > PINNACLE_SPI_BUFFER_SIZE) {
+                    spi->transfer(_buffer, bufSize);
+                    bufSize = 0;
+                }
+                _buffer[bufSize++] = (uint8_t)(0x80 | (operations[i].address + j));
+                _buffer[bufSize++] = operations[i].data[j];
+    #else  // !defined(PINNACLE_SPI_BUFFER_OPS)
+                spi->transfer((uint8_t)(0x80 | (operations[i].address + j)));
+                spi->transfer(operations[i].data[j]);
+    #endif // !defined(PINNACLE_SPI_BUFFER_OPS)
+            }
+        }
+    #ifdef PINNACLE_SPI_BUFFER_OPS
+        if (bufSize)
+            spi->transfer(_buffer, bufSize);
+    #endif
+        PINNACLE_SS_CTRL(_slaveSelect, HIGH);
+    }
+#else  // !PINNACLE_SPI_BURST_WRITES
+    PinnacleTouch::rapSubmit(operations, count);
+#endif
+}
+
+const void* PinnacleTouchSPI::busObject() const
+{
+    return spi;
+}
+
 #ifdef SPI_HAS_TRANSACTION
+void PinnacleTouchSPI::beginBusTransaction()
+{
+    PINNACLE_USE_ARDUINO_API
+    spi->beginTransaction(SPISettings(_spiSpeed, MSBFIRST, SPI_MODE1));
+}
+
+void PinnacleTouchSPI::endBusTransaction()
+{
     spi->endTransaction();
+}
 #endif
+
+#ifdef PINNACLE_BUS_LOCK
+void PinnacleTouchSPI::lockBus()
+{
+    spi->lock();
 }
 
+void PinnacleTouchSPI::unlockBus()
+{
+    spi->unlock();
+}
+#endif
+
 PinnacleTouchI2C::PinnacleTouchI2C(pinnacle_gpio_t dataReadyPin, uint8_t slaveAddress)
-    : PinnacleTouch(dataReadyPin), _slaveAddress(slaveAddress)
+    : PinnacleTouchStatic(dataReadyPin), _slaveAddress(slaveAddress)
 {
 }
 
@@ -710,15 +1423,32 @@ bool PinnacleTouchI2C::begin(pinnacle_i2c_t* i2c_bus)
 }
 
 bool PinnacleTouchI2C::begin()
+{
+    return PinnacleTouchI2C::begin(startBus());
+}
+
+bool PinnacleTouchI2C::fastBegin(pinnacle_i2c_t* i2c_bus, const PinnacleConfigSnapshot* snapshot)
+{
+    i2c = i2c_bus;
+    return PinnacleTouch::fastBegin(snapshot);
+}
+
+bool PinnacleTouchI2C::fastBegin(const PinnacleConfigSnapshot* snapshot)
+{
+    return PinnacleTouchI2C::fastBegin(startBus(), snapshot);
+}
+
+pinnacle_i2c_t* PinnacleTouchI2C::startBus()
 {
     PINNACLE_USE_ARDUINO_API
     Wire.begin();
     // no max/min I2C clock speed is specified (in ASIC's specs); use MCU default.
-    return PinnacleTouchI2C::begin(&Wire);
+    return &Wire;
 }
 
 void PinnacleTouchI2C::rapWriteCmd(uint8_t* sequence, uint8_t len)
 {
+    BusSession session(this);
     i2c->beginTransmission(_slaveAddress);
     for (uint8_t i = 0; i < len; ++i) {
         i2c->write(sequence[i]);
@@ -728,6 +1458,7 @@ void PinnacleTouchI2C::rapWriteCmd(uint8_t* sequence, uint8_t len)
 
 void PinnacleTouchI2C::rapWrite(uint8_t registerAddress, uint8_t registerValue)
 {
+    BusSession session(this);
     i2c->beginTransmission(_slaveAddress);
     i2c->write(0x80 | registerAddress);
     i2c->write(registerValue);
@@ -736,6 +1467,7 @@ void PinnacleTouchI2C::rapWrite(uint8_t registerAddress, uint8_t registerValue)
 
 void PinnacleTouchI2C::rapWriteBytes(uint8_t registerAddress, uint8_t* registerValues, uint8_t registerCount)
 {
+    BusSession session(this);
     i2c->beginTransmission(_slaveAddress);
     for (uint8_t i = 0; i < registerCount; ++i) {
         i2c->write(0x80 | (registerAddress + i));
@@ -746,11 +1478,17 @@ void PinnacleTouchI2C::rapWriteBytes(uint8_t registerAddress, uint8_t* registerV
 
 void PinnacleTouchI2C::rapRead(uint8_t registerAddress, uint8_t* data)
 {
+    BusSession session(this);
     rapReadBytes(registerAddress, data, 1);
 }
 
 void PinnacleTouchI2C::rapReadBytes(uint8_t registerAddress, uint8_t* data, uint8_t registerCount)
 {
+    BusSession session(this);
+#ifdef PINNACLE_I2C_WRITE_READ
+    uint8_t command = 0xA0 | registerAddress;
+    i2c->writeRead(_slaveAddress, &command, 1, data, registerCount);
+#else  // !defined(PINNACLE_I2C_WRITE_READ)
     uint8_t i = 0;
     i2c->beginTransmission(_slaveAddress);
     i2c->write(0xA0 | registerAddress);
@@ -759,4 +1497,60 @@ void PinnacleTouchI2C::rapReadBytes(uint8_t registerAddress, uint8_t* data, uint
     while (i2c->available()) {
         data[i++] = i2c->read();
     }
+#endif // !defined(PINNACLE_I2C_WRITE_READ)
+}
+
+void PinnacleTouchI2C::rapReadPacket(uint8_t registerAddress, uint8_t* data, uint8_t registerCount)
+{
+    BusSession session(this);
+    // qualified calls bypass the virtual functions (see PinnacleTouchStatic)
+    PinnacleTouchI2C::rapReadBytes(registerAddress, data, registerCount);
+    PinnacleTouchI2C::rapWrite(Status::address, 0);
+}
+
+void PinnacleTouchI2C::rapSubmit(const RapOperation* operations, uint8_t count)
+{
+    BusSession session(this);
+    uint8_t txSize = 0; // bytes in the unfinished transmission
+    for (uint8_t i = 0; i < count; ++i) {
+        if (operations[i].read) {
+            if (txSize) {
+                i2c->endTransmission(true);
+                txSize = 0;
+            }
+            rapReadBytes(operations[i].address, operations[i].data, operations[i].count);
+            continue;
+        }
+        // adjacent write operations are sent as address/value pairs in as few transmissions as possible
+        for (uint8_t j = 0; j < operations[i].count; ++j) {
+            if (txSize + 2 > PINNACLE_I2C_TX_LIMIT) {
+                i2c->endTransmission(true);
+                txSize = 0;
+            }
+            if (!txSize)
+                i2c->beginTransmission(_slaveAddress);
+            i2c->write(0x80 | (operations[i].address + j));
+            i2c->write(operations[i].data[j]);
+            txSize += 2;
+        }
+    }
+    if (txSize)
+        i2c->endTransmission(true);
 }
+
+const void* PinnacleTouchI2C::busObject() const
+{
+    return i2c;
+}
+
+#ifdef PINNACLE_BUS_LOCK
+void PinnacleTouchI2C::lockBus()
+{
+    i2c->lock();
+}
+
+void PinnacleTouchI2C::unlockBus()
+{
+    i2c->unlock();
+}
+#endif
@@ -20,8 +20,13 @@
 #define _CIRQUEPINNACLE_H_
 #include <stdint.h>
 #include "CirquePinnacle_common.h"
+#include "CirquePinnacle_registers.h"
 
-/* Defined constants for Pinnacle registers */
+/*
+ * Defined constants for Pinnacle registers.
+ * Deprecated: these are only kept for compatibility. The library uses the `pinnacle_registers`
+ * model (see CirquePinnacle_registers.h).
+ */
 #define PINNACLE_FIRMWARE_ID    0x00
 #define PINNACLE_STATUS         0x02
 #define PINNACLE_SYS_CONFIG     0x03
@@ -41,6 +46,37 @@
 #define PINNACLE_ERA_CONTROL    0x1E
 #define PINNACLE_HCO_ID         0x1F
 
+/* The range of RAP registers that can be mirrored in local memory */
+#define PINNACLE_CACHE_START pinnacle_registers::SysConfig::address
+#define PINNACLE_CACHE_SIZE  (pinnacle_registers::ZIdle::address - pinnacle_registers::SysConfig::address + 1)
+
+// the deprecated constants must stay in sync with the register model
+static_assert(PINNACLE_FIRMWARE_ID == pinnacle_registers::FirmwareId::address, "PINNACLE_FIRMWARE_ID is out of sync");
+static_assert(PINNACLE_STATUS == pinnacle_registers::Status::address, "PINNACLE_STATUS is out of sync");
+static_assert(PINNACLE_SYS_CONFIG == pinnacle_registers::SysConfig::address, "PINNACLE_SYS_CONFIG is out of sync");
+static_assert(PINNACLE_FEED_CONFIG_1 == pinnacle_registers::FeedConfig1::address, "PINNACLE_FEED_CONFIG_1 is out of sync");
+static_assert(PINNACLE_FEED_CONFIG_2 == pinnacle_registers::FeedConfig2::address, "PINNACLE_FEED_CONFIG_2 is out of sync");
+static_assert(PINNACLE_FEED_CONFIG_3 == pinnacle_registers::FeedConfig3::address, "PINNACLE_FEED_CONFIG_3 is out of sync");
+static_assert(PINNACLE_CAL_CONFIG == pinnacle_registers::CalConfig::address, "PINNACLE_CAL_CONFIG is out of sync");
+static_assert(PINNACLE_SAMPLE_RATE == pinnacle_registers::SampleRate::address, "PINNACLE_SAMPLE_RATE is out of sync");
+static_assert(PINNACLE_Z_IDLE == pinnacle_registers::ZIdle::address, "PINNACLE_Z_IDLE is out of sync");
+static_assert(PINNACLE_Z_SCALER == pinnacle_registers::ZScaler::address, "PINNACLE_Z_SCALER is out of sync");
+static_assert(PINNACLE_SLEEP_INTERVAL == pinnacle_registers::SleepInterval::address, "PINNACLE_SLEEP_INTERVAL is out of sync");
+static_assert(PINNACLE_SLEEP_TIMER == pinnacle_registers::SleepTimer::address, "PINNACLE_SLEEP_TIMER is out of sync");
+static_assert(PINNACLE_PACKET_BYTE_0 == pinnacle_registers::PacketByte0::address, "PINNACLE_PACKET_BYTE_0 is out of sync");
+static_assert(PINNACLE_PACKET_BYTE_1 == pinnacle_registers::PacketByte1::address, "PINNACLE_PACKET_BYTE_1 is out of sync");
+static_assert(PINNACLE_ERA_VALUE == pinnacle_registers::EraValue::address, "PINNACLE_ERA_VALUE is out of sync");
+static_assert(PINNACLE_ERA_ADDR == pinnacle_registers::EraAddr::address, "PINNACLE_ERA_ADDR is out of sync");
+static_assert(PINNACLE_ERA_CONTROL == pinnacle_registers::EraControl::address, "PINNACLE_ERA_CONTROL is out of sync");
+static_assert(PINNACLE_HCO_ID == pinnacle_registers::HcoId::address, "PINNACLE_HCO_ID is out of sync");
+
+#ifndef PINNACLE_SPI_BUFFER_SIZE
+    // The size of the per-instance buffer used for SPI transactions on platforms that transfer
+    // whole buffers (PINNACLE_SPI_BUFFER_OPS). 20 bytes fits the largest burst of register
+    // writes (10 registers in anymeasModeConfig()); longer reads and writes are split.
+    #define PINNACLE_SPI_BUFFER_SIZE 20
+#endif
+
 // *************** defined Constants for bitwise configuration *****************
 /**
  * Allowed symbols for configuring the Pinnacle ASIC's data
@@ -174,6 +210,118 @@ enum PinnacleAnyMeasCtrl : uint8_t
 
 #endif // PINNACLE_ANYMEAS_SUPPORT == false
 
+#ifndef PINNACLE_ERA_QUEUE_SIZE
+    /**
+     * The maximum number of extended register operations that can be queued with
+     * `PinnacleTouch::eraQueueRead()` and `PinnacleTouch::eraQueueWrite()`.
+     */
+    #define PINNACLE_ERA_QUEUE_SIZE 8
+#endif
+
+#ifndef PINNACLE_BOOT_TIMEOUT
+    /**
+     * The maximum number of milliseconds that ``fastBegin()`` waits for the Pinnacle ASIC to
+     * answer (see `PinnacleTouchSPI::fastBegin()` or `PinnacleTouchI2C::fastBegin()`).
+     */
+    #define PINNACLE_BOOT_TIMEOUT 100
+#endif
+
+/**
+ * The states reported by `PinnacleTouch::eraPoll()`.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+enum PinnacleEraStatus : uint8_t
+{
+    /** There are no queued extended register operations. */
+    PINNACLE_ERA_IDLE = 0x00,
+    /** Queued extended register operations are still in progress. */
+    PINNACLE_ERA_BUSY = 0x01,
+    /**
+     * All queued extended register operations have finished, and the data feed has been
+     * restored to its previous state. This is only reported once per batch of operations.
+     */
+    PINNACLE_ERA_COMPLETE = 0x02,
+};
+
+/**
+ * The version of the blob made by `PinnacleConfigSnapshot::serialize()`.
+ * `PinnacleConfigSnapshot::deserialize()` rejects blobs of any other version.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+#define PINNACLE_CONFIG_BLOB_VERSION 1
+
+/**
+ * The size (in bytes) of the blob made by `PinnacleConfigSnapshot::serialize()`.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+#define PINNACLE_CONFIG_BLOB_SIZE 107
+
+/**
+ * A tuned trackpad's configuration. Use `PinnacleTouch::getConfigSnapshot()` to capture it,
+ * then give it to ``fastBegin()`` (see `PinnacleTouchSPI::fastBegin()` or
+ * `PinnacleTouchI2C::fastBegin()`) to restore it without calibrating again. A running
+ * trackpad can be reconfigured with `PinnacleTouch::setConfigSnapshot()`.
+ *
+ * The extended registers (all members after `config`) are all zeros for trackpads
+ * manufactured on or after 2025.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+struct PinnacleConfigSnapshot
+{
+    /**
+     * The values of the configuration registers (``SYS_CONFIG`` through ``Z_IDLE``).
+     */
+    uint8_t config[PINNACLE_CACHE_SIZE];
+    /**
+     * The reload timer that sets the sample rate (see `PinnacleTouch::setSampleRate()`).
+     */
+    uint8_t reloadTimer;
+    /**
+     * The ADC configuration (see `PinnacleTouch::setAdcGain()`).
+     */
+    uint8_t adcConfig;
+    /**
+     * The minimum Z value for the edges of the X axis (see `PinnacleTouch::tuneEdgeSensitivity()`).
+     */
+    uint8_t xAxisWideZMin;
+    /**
+     * The minimum Z value for the edges of the Y axis (see `PinnacleTouch::tuneEdgeSensitivity()`).
+     */
+    uint8_t yAxisWideZMin;
+    /**
+     * The finger and stylus detection flags (see `PinnacleTouch::detectFingerStylus()`).
+     */
+    uint8_t fingerStylus;
+    /**
+     * The compensation matrix (see `PinnacleTouch::getCalibrationMatrix()`).
+     */
+    int16_t calibrationMatrix[46];
+
+    /**
+     * Store this configuration in a compact binary blob.
+     *
+     * The blob starts with `PINNACLE_CONFIG_BLOB_VERSION` and ends with a checksum. All
+     * multi-byte values are big endian, so the blob can be moved between platforms.
+     *
+     * @param[out] blob A buffer of at least `PINNACLE_CONFIG_BLOB_SIZE` bytes.
+     */
+    void serialize(uint8_t* blob) const;
+
+    /**
+     * Load a configuration from a blob made by `serialize()`.
+     *
+     * @param blob A buffer of `PINNACLE_CONFIG_BLOB_SIZE` bytes.
+     *
+     * @returns ``false`` if the ``blob`` is of another version or its checksum does not
+     *     match (this object is not changed). Otherwise ``true``.
+     */
+    bool deserialize(const uint8_t* blob);
+};
+
 /**
  * This data structure is used for returning data reports in relative mode using
  * :cpp:expr:`PinnacleTouch::read(RelativeReport*)`.
@@ -310,6 +458,32 @@ public:
      *     is given `~PinnacleDataMode::PINNACLE_ANYMEAS`.
      */
     bool isFeedEnabled();
+    /**
+     * This function controls if the Pinnacle ASIC's configuration registers are mirrored in
+     * local memory. The mirrored registers are ``SYS_CONFIG``, ``FEED_CONFIG_1`` through
+     * ``FEED_CONFIG_3``, ``CAL_CONFIG``, ``SAMPLE_RATE``, and ``Z_IDLE``.
+     *
+     * While enabled, getters (like `isFeedEnabled()`) and the read-modify-write done by setters
+     * (like `feedEnabled()`) are served from local memory, and a register is only written when
+     * its value actually changes. This saves a bus transaction for most configuration calls
+     * (including every extended register access).
+     *
+     * .. note::
+     *     The local copy is (re)populated with a single burst read the next time a mirrored
+     *     register is needed. If the Pinnacle ASIC is reset by other means (eg. a power cycle),
+     *     then call this function again to discard the stale copy.
+     *
+     * @param isEnabled Enables (``true``) or disables (``false``) the register cache. Disabled
+     *     by default.
+     */
+    void registerCacheEnabled(bool isEnabled);
+    /**
+     * This function describes if the Pinnacle ASIC's configuration registers are mirrored
+     * in local memory.
+     *
+     * @returns The setting configured by `registerCacheEnabled()`.
+     */
+    bool isRegisterCacheEnabled();
     /**
      * This function controls the mode for which kind of data to report.
      *
@@ -389,10 +563,28 @@ public:
      * is active. Data, new or antiquated, can be retrieved using
      * `read()` depending on what `setDataMode()` is given.
      *
+     * .. note::
+     *     The "data ready" pin takes a moment (about 50 microseconds) to deactivate after
+     *     the interrupt signal is cleared by `read()` or `clearStatusFlags()`. Rather than
+     *     waiting for this, those functions return immediately, and this function will
+     *     report ``false`` until that moment has passed.
+     *
      * @returns ``true`` if there is new data to report; ``false`` if there is no
      *     new data to report.
      */
     bool available();
+    /**
+     * Wait until there is new data to report (see `available()`) or until a timeout expires.
+     *
+     * On Linux, this sleeps until the "data ready" pin's rising edge is detected, so the
+     * application does not use any CPU time while waiting. On other platforms, this repeatedly
+     * checks `available()` until the timeout expires.
+     *
+     * @param timeout The maximum number of milliseconds to wait.
+     * @returns ``true`` if there is new data to report; ``false`` if the timeout expired
+     *     without new data to report.
+     */
+    bool waitAvailable(uint32_t timeout);
     /**
      * Configure settings specific to Absolute mode (reports axis positions). This function only
      * applies to `~PinnacleDataMode::PINNACLE_ABSOLUTE` mode, otherwise if `setDataMode()` is given
@@ -474,12 +666,51 @@ public:
      * @id AbsoluteReport
      */
     void read(AbsoluteReport* report, bool readButtons = true);
+    /**
+     * Use this function like `read()`, but also get the time at which the data became
+     * available.
+     *
+     * On Linux, the timestamp is taken from the kernel's detection of the "data ready" pin's
+     * rising edge, so it is not affected by delays in the application or on the bus. If no
+     * rising edge was detected (eg. the data was already available when the trackpad was
+     * configured), then the current time is used instead.
+     *
+     * On other platforms, the timestamp is the time at which this function is called.
+     *
+     * @param[out] report A reference pointer (declared variable of datatype
+     *     `RelativeReport`) for storing the data that describes the touch (and
+     *     button) event.
+     * @param[out] timestamp A reference pointer for storing the timestamp in nanoseconds.
+     *     On Linux, this uses the system's monotonic clock (``CLOCK_MONOTONIC``). On other
+     *     platforms, this is based on ``micros()``, which overflows about every 71 minutes.
+     * @param readButtons See `read()`.
+     *
+     * @id RelativeReportTimestamped
+     */
+    void readTimestamped(RelativeReport* report, uint64_t* timestamp, bool readButtons = true);
+    /**
+     * Use this function like `read()`, but also get the time at which the data became
+     * available. See `readTimestamped(RelativeReport*, uint64_t*, bool)` for details about the
+     * timestamp.
+     *
+     * @param[out] report A reference pointer (declared variable of datatype
+     *     `AbsoluteReport`) for storing the data that describes the touch (and
+     *     button) event.
+     * @param[out] timestamp A reference pointer for storing the timestamp in nanoseconds.
+     * @param readButtons See `read()`.
+     *
+     * @id AbsoluteReportTimestamped
+     */
+    void readTimestamped(AbsoluteReport* report, uint64_t* timestamp, bool readButtons = true);
     /**
      * Use this function to clear the interrupt signal (digital input; active
      * when HIGH) on the "data ready" pin (marked "DR" in the
      * `pinout <index.html#pinout>`_ section). This function is mainly used
      * internally when applicable, but it is left exposed if the application
      * wants to neglect a data report when desirable.
+     *
+     * This function does not wait for the "data ready" pin to deactivate; see the note in
+     * `available()`.
      */
     void clearStatusFlags();
     /**
@@ -659,6 +890,48 @@ public:
      *     "power-on-reset" condition).
      */
     void getCalibrationMatrix(int16_t* matrix);
+    /**
+     * Capture the trackpad's configuration (including the compensation matrix).
+     *
+     * The captured configuration can be restored later (for example, after the application
+     * restarts) by giving it to ``fastBegin()`` (see `PinnacleTouchSPI::fastBegin()` or
+     * `PinnacleTouchI2C::fastBegin()`).
+     *
+     * .. note:: Only configurations of `~PinnacleDataMode::PINNACLE_RELATIVE` or
+     *     `~PinnacleDataMode::PINNACLE_ABSOLUTE` mode can be restored.
+     *
+     * @param[out] snapshot The object that stores the configuration. This is not changed if
+     *     `setDataMode()` is given `~PinnacleDataMode::PINNACLE_ERROR`.
+     */
+    void getConfigSnapshot(PinnacleConfigSnapshot* snapshot);
+    /**
+     * Restore a configuration captured with `getConfigSnapshot()`.
+     *
+     * This replaces a series of individual setter calls. The configuration registers are
+     * compared with the trackpad's values (mirrored ones are not read again; see
+     * `registerCacheEnabled()`), and only the changed registers are written. The extended
+     * registers are only written if they differ from the ``current`` configuration.
+     * Otherwise, all of them are written because reading them costs as much as writing them.
+     *
+     * .. code-block:: cpp
+     *
+     *     PinnacleConfigSnapshot defaults, tuned;
+     *     trackpad.getConfigSnapshot(&defaults); // right after begin()
+     *     tuned.deserialize(blob);                // stored when the device was provisioned
+     *     trackpad.setConfigSnapshot(&tuned, &defaults);
+     *
+     * @param snapshot The configuration to restore. Its data mode is also restored. Calibration,
+     *     reset, shutdown, and AnyMeas mode flags in it are ignored.
+     * @param current The trackpad's present configuration (if known). Pass ``nullptr`` if the
+     *     trackpad may have been changed since it was captured.
+     *
+     * .. note:: This holds a `BusSession` for the whole restore, so other threads that share the
+     *     bus can't change the trackpad part way through.
+     *
+     * @returns ``false`` if `setDataMode()` was not given `~PinnacleDataMode::PINNACLE_RELATIVE`
+     *     or `~PinnacleDataMode::PINNACLE_ABSOLUTE` (nothing is written). Otherwise ``true``.
+     */
+    bool setConfigSnapshot(const PinnacleConfigSnapshot* snapshot, const PinnacleConfigSnapshot* current = nullptr);
     /**
      * Sets the ADC (Analog to Digital Converter) attenuation (gain ratio) to
      * enhance performance based on the overlay type. This does not apply to
@@ -815,23 +1088,232 @@ public:
      */
     int16_t getMeasureAdc();
 #endif // PINNACLE_ANYMEAS_SUPPORT == true
+    /**
+     * Queue a write to one of the Pinnacle ASIC's extended registers. Nothing is sent over the
+     * bus until `eraPoll()` is called.
+     *
+     * .. warning::
+     *     This directly alters values in the Pinnacle ASIC's memory. Do not call other
+     *     functions that access extended registers (eg. `setAdcGain()`) until `eraPoll()`
+     *     stops returning `~PinnacleEraStatus::PINNACLE_ERA_BUSY`.
+     *
+     * @param registerAddress The 16-bit address of the extended register.
+     * @param registerValue The value to write.
+     * @returns ``false`` if the queue is full (see `PINNACLE_ERA_QUEUE_SIZE`) or `begin()`
+     *     failed to initialize the trackpad; ``true`` otherwise.
+     */
+    bool eraQueueWrite(uint16_t registerAddress, uint8_t registerValue);
+    /**
+     * Queue a read from one of the Pinnacle ASIC's extended registers. Nothing is sent over
+     * the bus until `eraPoll()` is called.
+     *
+     * @param registerAddress The 16-bit address of the extended register.
+     * @param[out] data A reference pointer to store the value in. This must stay valid until
+     *     `eraPoll()` returns `~PinnacleEraStatus::PINNACLE_ERA_COMPLETE`.
+     * @returns ``false`` if ``data`` is null, the queue is full (see `PINNACLE_ERA_QUEUE_SIZE`),
+     *     or `begin()` failed to initialize the trackpad; ``true`` otherwise.
+     */
+    bool eraQueueRead(uint16_t registerAddress, uint8_t* data);
+    /**
+     * Advance the queued extended register operations by one step without waiting on the
+     * Pinnacle ASIC. Call this repeatedly (eg. from the application's main loop) until the
+     * queue is finished; other work can be done between calls.
+     *
+     * The data feed is disabled (if it was enabled) when the first queued operation starts,
+     * and restored after the last queued operation finishes.
+     *
+     * If the bus driver throws an exception, then all queued operations are dropped (the
+     * data feed stays disabled). The queue is also emptied by ``begin()``.
+     *
+     * While a blocking extended register access (eg. `tuneEdgeSensitivity()`) is in progress,
+     * this does nothing and returns `~PinnacleEraStatus::PINNACLE_ERA_BUSY`.
+     *
+     * @returns A value from `PinnacleEraStatus`.
+     */
+    PinnacleEraStatus eraPoll();
+    /**
+     * @returns The number of queued extended register operations that have not finished.
+     */
+    uint8_t eraPending();
+
+    /**
+     * A scoped object that keeps the trackpad's bus configured (and reserved) for a sequence of
+     * register accesses.
+     *
+     * While the outermost session exists,
+     *
+     * - the SPI bus' ``beginTransaction()`` is only called once (when the session is
+     *   constructed) and ``endTransaction()`` is only called when the session is destroyed.
+     *   Without a session, each register access begins and ends its own SPI transaction.
+     * - the bus object is locked (on Linux), so that accesses from other threads (or processes)
+     *   that share the bus are not interleaved with the sequence.
+     *
+     * Sessions can be nested; only the outermost session begins and ends the transaction.
+     * This library already uses a session for each data report, the register setup in
+     * :cpp:func:`~PinnacleTouchSPI::begin()`, and `getConfigSnapshot()` or `setConfigSnapshot()`.
+     * Calibration and extended register accesses do not hold the bus while they wait on the
+     * Pinnacle ASIC (unless the application holds a session). Applications can use a session to
+     * group several configuration calls.
+     *
+     * .. code-block:: cpp
+     *
+     *     {
+     *         PinnacleTouch::BusSession session(&trackpad);
+     *         trackpad.setSampleRate(200);
+     *         trackpad.absoluteModeConfig(1);
+     *     } // bus is released here
+     *
+     * .. warning::
+     *     On the Arduino platform, other devices on the same SPI bus cannot be used while a
+     *     session exists. Keep sessions short.
+     */
+    class BusSession
+    {
+    public:
+        /**
+         * Start a session.
+         *
+         * @param touch The trackpad whose bus is used. The trackpad's ``begin()`` must have been
+         *     called first.
+         */
+        BusSession(PinnacleTouch* touch);
+        /** End the session. */
+        ~BusSession();
+        BusSession(const BusSession&) = delete;
+        BusSession& operator=(const BusSession&) = delete;
+
+    private:
+        PinnacleTouch* _touch;
+    };
+
+protected:
+    /**
+     * One register access in a program given to ``rapSubmit()``. The operations of a program
+     * are executed in order, but adjacent operations may be merged into the same bus transfer.
+     */
+    struct RapOperation
+    {
+        uint8_t address; // the first register's address
+        uint8_t* data;   // the values to write or the buffer to read into
+        uint8_t count;   // the number of registers (at consecutive addresses)
+        bool read;       // true for a read operation, false for a write operation
+    };
+
+    /** @returns The pin connected to the Data Ready output. */
+    pinnacle_gpio_t dataReadyPin() const
+    {
+        return _dataReady;
+    }
+
+    /**
+     * Tells `available()` that a rising edge of the Data Ready pin was just consumed. The edge
+     * means new data, so the pin's level is no longer ignored after `clearStatusFlags()`.
+     */
+    void edgeConsumed();
 
 private:
     void eraWrite(uint16_t, uint8_t);
     void eraWriteBytes(uint16_t, uint8_t, uint8_t);
+    void eraWriteBuffer(uint16_t, uint8_t*, uint8_t);
     void eraRead(uint16_t, uint8_t*);
     void eraReadBytes(uint16_t, uint8_t*, uint8_t);
+    void eraPrepare();
+    void eraStart(uint16_t, uint8_t);
+    void eraStartWrite(uint16_t, uint8_t, uint8_t);
+    bool eraBusy();
+    void eraWait();
+    void eraSuspendFeed();
+    void eraResumeFeed();
+    void eraQueueClear();
+    void cachedRead(uint8_t, uint8_t*);
+    void cachedWrite(uint8_t, uint8_t);
+    void cachedWriteBytes(uint8_t, uint8_t*, uint8_t);
+    void cachedSubmit(RapOperation*, uint8_t);
+    bool configure(const PinnacleConfigSnapshot*);
+    // setConfigSnapshot() without holding the bus (used by configure())
+    void restoreConfig(const PinnacleConfigSnapshot*, const PinnacleConfigSnapshot*);
+    void enableIntellimouse();
+    // write the fields of a register (only reads the register if the update is partial)
+    template <class Register>
+    void writeFields(PinnacleRegisterUpdate<Register>);
+    bool cacheTrim(RapOperation&);
+    void syncCache();
     PinnacleDataMode _dataMode;
     bool _intellimouse;
     bool _rev2025;
+    bool _cacheEnabled;
+    bool _cacheValid;
+    bool _eraFeedState;
+    uint8_t _eraDepth;
+    uint8_t _busDepth; // number of nested BusSession objects
+    struct EraOperation
+    {
+        uint16_t address;
+        uint8_t value;
+        uint8_t* data; // nullptr for write operations
+    } _eraQueue[PINNACLE_ERA_QUEUE_SIZE];
+    uint8_t _eraQueueHead;
+    uint8_t _eraQueueCount;
+    bool _eraQueueActive;
+    bool _eraQueueHeld;
+    uint8_t _cache[PINNACLE_CACHE_SIZE];
     const pinnacle_gpio_t _dataReady;
+    bool _clearPending;
+    uint32_t _clearTime;
     virtual void rapWriteCmd(uint8_t*, uint8_t) = 0;
     virtual void rapWrite(uint8_t, uint8_t) = 0;
     virtual void rapWriteBytes(uint8_t, uint8_t*, uint8_t) = 0;
     virtual void rapRead(uint8_t, uint8_t*) = 0;
     virtual void rapReadBytes(uint8_t, uint8_t*, uint8_t) = 0;
+    // read a data packet and clear the Status register in as few bus transactions as possible
+    virtual void rapReadPacket(uint8_t, uint8_t*, uint8_t);
+    // execute a program of register accesses as 1 unit (merging adjacent operations where possible)
+    virtual void rapSubmit(const RapOperation*, uint8_t);
+    void statusCleared();
+    uint64_t dataReadyTimestamp();
+    // decode a data packet read by rapReadPacket() (shared by all read() implementations,
+    // including the handles, which pass compile-time constants)
+    static void unpackReport(RelativeReport*, const uint8_t*, bool readButtons, bool intellimouse);
+    static void unpackReport(AbsoluteReport*, const uint8_t*, bool readButtons);
+    // identifies the bus object used (for grouping transactions of trackpads on the same bus)
+    virtual const void* busObject() const;
+#ifdef PINNACLE_BUS_LOCK
+    // take/release exclusive access to the bus object (nestable)
+    virtual void lockBus();
+    virtual void unlockBus();
+#endif
+    // called when the outermost BusSession starts/ends
+    virtual void beginBusTransaction();
+    virtual void endBusTransaction();
+    friend class PinnacleTouchManager;
+    template <class>
+    friend class PinnacleTouchStatic;
+    template <class, bool>
+    friend class PinnacleAbsoluteHandle;
+    template <class, bool, bool>
+    friend class PinnacleRelativeHandle;
 
 protected:
+    /**
+     * A scoped object that suspends the data feed once for a batch of extended register
+     * accesses (ERA). The feed is disabled (if it was enabled) when the first session is
+     * constructed and restored when the outermost session is destroyed. Nested sessions
+     * (including the one opened by each individual ERA operation) do not touch the feed.
+     * The bus is not held between register accesses, because ERA operations wait on the
+     * Pinnacle ASIC.
+     */
+    class EraSession
+    {
+    public:
+        EraSession(PinnacleTouch* touch);
+        ~EraSession();
+        EraSession(const EraSession&) = delete;
+        EraSession& operator=(const EraSession&) = delete;
+
+    private:
+        PinnacleTouch* _touch;
+    };
+
     /**
      * Starts the driver interface on the appropriate data bus.
      *
@@ -842,6 +1324,292 @@ protected:
      *       operations will be nullified by `setDataMode()` to `~PinnacleDataMode::PINNACLE_ERROR`.
      */
     bool begin();
+
+    /**
+     * Same as `begin()`, but faster.
+     *
+     * - Instead of always waiting 100 milliseconds, the firmware ID is polled until the
+     *   Pinnacle ASIC answers (for up to `PINNACLE_BOOT_TIMEOUT` milliseconds).
+     * - If a ``snapshot`` is given, then it is restored (see `setConfigSnapshot()`) instead
+     *   of calibrating again. Trackpads manufactured on or after 2025 are still
+     *   calibrated (they have no compensation matrix to restore).
+     *
+     * @param snapshot The configuration captured with `getConfigSnapshot()`. If this is
+     *     ``nullptr``, then the trackpad is configured like `begin()`.
+     */
+    bool fastBegin(const PinnacleConfigSnapshot* snapshot);
+};
+
+inline void PinnacleTouch::unpackReport(RelativeReport* report, const uint8_t* buffer, bool readButtons, bool intellimouse)
+{
+    uint8_t skip = !readButtons;
+    if (readButtons) {
+        report->buttons &= 0xF8;
+        report->buttons |= buffer[0] & 7;
+    }
+    report->x = (int8_t)buffer[1 - skip];
+    report->y = (int8_t)buffer[2 - skip];
+    if (intellimouse)
+        report->scroll = (int8_t)buffer[3 - skip];
+}
+
+inline void PinnacleTouch::unpackReport(AbsoluteReport* report, const uint8_t* buffer, bool readButtons)
+{
+    uint8_t skip = (!readButtons) * 2;
+    if (readButtons) {
+        report->buttons &= 0xF8;
+        report->buttons |= buffer[0] & 0x3F;
+    }
+    report->x = (uint16_t)(((buffer[4 - skip] & 0x0F) << 8) | buffer[2 - skip]);
+    report->y = (uint16_t)(((buffer[4 - skip] & 0xF0) << 4) | buffer[3 - skip]);
+    report->z = (uint8_t)(buffer[5 - skip] & 0x1F);
+}
+
+template <class Transport, bool ReadButtons = true>
+class PinnacleAbsoluteHandle;
+template <class Transport, bool ReadButtons = true, bool Intellimouse = false>
+class PinnacleRelativeHandle;
+
+/**
+ * A base class that binds the data bus at compile time.
+ *
+ * The ``Transport`` is the derived class that implements the data bus (`PinnacleTouchSPI` or
+ * `PinnacleTouchI2C`). When called on an object of the derived class, `read()` and
+ * `readTimestamped()` use the ``Transport`` directly (instead of the virtual functions used by
+ * `PinnacleTouch`), so the compiler can optimize the report read path for that data bus.
+ *
+ * Calling these functions through a `PinnacleTouch` pointer or reference has the same result.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+template <class Transport>
+class PinnacleTouchStatic : public PinnacleTouch
+{
+public:
+    /**
+     * Same as :cpp:expr:`PinnacleTouch::read(RelativeReport*, bool)`.
+     */
+    void read(RelativeReport* report, bool readButtons = true)
+    {
+        if (_dataMode == PINNACLE_RELATIVE) {
+            uint8_t buffer[4] = {0};
+            uint8_t skip = !readButtons;
+            readPacket(pinnacle_registers::PacketByte0::address + skip, buffer, 3 - skip + _intellimouse);
+            unpackReport(report, buffer, readButtons, _intellimouse);
+        }
+    }
+
+    /**
+     * Same as :cpp:expr:`PinnacleTouch::read(AbsoluteReport*, bool)`.
+     */
+    void read(AbsoluteReport* report, bool readButtons = true)
+    {
+        if (_dataMode == PINNACLE_ABSOLUTE) {
+            uint8_t buffer[6] = {0};
+            uint8_t skip = (!readButtons) * 2;
+            readPacket(pinnacle_registers::PacketByte0::address + skip, buffer, 6 - skip);
+            unpackReport(report, buffer, readButtons);
+        }
+    }
+
+    /**
+     * Same as :cpp:expr:`PinnacleTouch::readTimestamped(RelativeReport*, uint64_t*, bool)`.
+     */
+    void readTimestamped(RelativeReport* report, uint64_t* timestamp, bool readButtons = true)
+    {
+        *timestamp = dataReadyTimestamp();
+        read(report, readButtons);
+    }
+
+    /**
+     * Same as :cpp:expr:`PinnacleTouch::readTimestamped(AbsoluteReport*, uint64_t*, bool)`.
+     */
+    void readTimestamped(AbsoluteReport* report, uint64_t* timestamp, bool readButtons = true)
+    {
+        *timestamp = dataReadyTimestamp();
+        read(report, readButtons);
+    }
+
+    /**
+     * Get a handle that reads reports in Absolute mode without any runtime mode checks.
+     *
+     * @tparam ReadButtons Whether the reports include the button states.
+     *     See the ``readButtons`` parameter of :cpp:expr:`read(AbsoluteReport*, bool)`.
+     *
+     * @returns A `PinnacleAbsoluteHandle` for this trackpad. Check its
+     *     :cpp:func:`~PinnacleAbsoluteHandle::isValid()` before using it.
+     */
+    template <bool ReadButtons = true>
+    PinnacleAbsoluteHandle<Transport, ReadButtons> absoluteHandle()
+    {
+        return PinnacleAbsoluteHandle<Transport, ReadButtons>(*this);
+    }
+
+    /**
+     * Get a handle that reads reports in Relative mode without any runtime mode checks.
+     *
+     * @tparam ReadButtons Whether the reports include the button states.
+     *     See the ``readButtons`` parameter of :cpp:expr:`read(RelativeReport*, bool)`.
+     * @tparam Intellimouse Whether the reports include scroll wheel data. This must match the
+     *     ``intellimouse`` feature's state (see `relativeModeConfig()`).
+     *
+     * @returns A `PinnacleRelativeHandle` for this trackpad. Check its
+     *     :cpp:func:`~PinnacleRelativeHandle::isValid()` before using it.
+     */
+    template <bool ReadButtons = true, bool Intellimouse = false>
+    PinnacleRelativeHandle<Transport, ReadButtons, Intellimouse> relativeHandle()
+    {
+        return PinnacleRelativeHandle<Transport, ReadButtons, Intellimouse>(*this);
+    }
+
+protected:
+    PinnacleTouchStatic(pinnacle_gpio_t dataReadyPin) : PinnacleTouch(dataReadyPin) {}
+
+private:
+    // read a data packet (and clear the Status flags) with the Transport's implementation
+    void readPacket(uint8_t registerAddress, uint8_t* data, uint8_t registerCount)
+    {
+        static_cast<Transport*>(this)->Transport::rapReadPacket(registerAddress, data, registerCount);
+        statusCleared();
+    }
+    template <class, bool>
+    friend class PinnacleAbsoluteHandle;
+    template <class, bool, bool>
+    friend class PinnacleRelativeHandle;
+};
+
+/**
+ * A handle that reads a trackpad's reports in Absolute mode.
+ *
+ * The data mode is checked once when the handle is made (see `isValid()`). Its `read()` has
+ * no runtime mode checks, and the packet's register offsets and length are constants. Reading
+ * a `RelativeReport` with this handle is a compile-time error.
+ *
+ * Get a handle from :cpp:func:`PinnacleTouchStatic::absoluteHandle()`.
+ *
+ * .. code-block:: cpp
+ *
+ *     trackpad.setDataMode(PINNACLE_ABSOLUTE);
+ *     auto absolute = trackpad.absoluteHandle();
+ *     AbsoluteReport report;
+ *     if (absolute.isValid() && trackpad.available()) {
+ *         absolute.read(&report);
+ *     }
+ *
+ * .. warning::
+ *     Do not use the handle after the trackpad's data mode changes (or the trackpad is
+ *     destroyed). Get a new handle instead.
+ *
+ * @tparam Transport The trackpad's class (`PinnacleTouchSPI` or `PinnacleTouchI2C`).
+ * @tparam ReadButtons Whether the reports include the button states.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+template <class Transport, bool ReadButtons>
+class PinnacleAbsoluteHandle
+{
+public:
+    /**
+     * @returns ``true`` if the trackpad was in Absolute mode when this handle was made.
+     */
+    bool isValid() const { return _valid; }
+
+    /**
+     * Same as :cpp:expr:`PinnacleTouch::read(AbsoluteReport*, bool)`, but without checking the
+     * data mode. Only use this if `isValid()` returns ``true``.
+     */
+    void read(AbsoluteReport* report)
+    {
+        uint8_t buffer[6 - SKIP];
+        _trackpad.readPacket(pinnacle_registers::PacketByte0::address + SKIP, buffer, 6 - SKIP);
+        PinnacleTouch::unpackReport(report, buffer, ReadButtons);
+    }
+
+    /**
+     * Same as `read()`, but also get the time at which the data became available. See
+     * :cpp:expr:`PinnacleTouch::readTimestamped(AbsoluteReport*, uint64_t*, bool)` for details.
+     */
+    void readTimestamped(AbsoluteReport* report, uint64_t* timestamp)
+    {
+        *timestamp = _trackpad.dataReadyTimestamp();
+        read(report);
+    }
+
+    // an Absolute mode handle can't read relative data
+    void read(RelativeReport* report) = delete;
+    void readTimestamped(RelativeReport* report, uint64_t* timestamp) = delete;
+
+private:
+    friend class PinnacleTouchStatic<Transport>;
+    PinnacleAbsoluteHandle(PinnacleTouchStatic<Transport>& trackpad)
+        : _trackpad(trackpad), _valid(trackpad._dataMode == PINNACLE_ABSOLUTE) {}
+    enum { SKIP = ReadButtons ? 0 : 2 }; // the number of packet bytes not read
+    PinnacleTouchStatic<Transport>& _trackpad;
+    bool _valid;
+};
+
+/**
+ * A handle that reads a trackpad's reports in Relative mode.
+ *
+ * The data mode (and the ``intellimouse`` feature's state) is checked once when the handle is
+ * made (see `isValid()`). Its `read()` has no runtime mode checks, and the packet's register
+ * offsets and length are constants. Reading an `AbsoluteReport` with this handle is a
+ * compile-time error.
+ *
+ * Get a handle from :cpp:func:`PinnacleTouchStatic::relativeHandle()`.
+ *
+ * .. warning::
+ *     Do not use the handle after the trackpad's data mode or Relative mode configuration
+ *     changes (or the trackpad is destroyed). Get a new handle instead.
+ *
+ * @tparam Transport The trackpad's class (`PinnacleTouchSPI` or `PinnacleTouchI2C`).
+ * @tparam ReadButtons Whether the reports include the button states.
+ * @tparam Intellimouse Whether the reports include scroll wheel data.
+ *
+ * @ingroup pinnacle-touch-api
+ */
+template <class Transport, bool ReadButtons, bool Intellimouse>
+class PinnacleRelativeHandle
+{
+public:
+    /**
+     * @returns ``true`` if the trackpad was in Relative mode (with the ``intellimouse`` feature
+     *     enabled only if ``Intellimouse`` is ``true``) when this handle was made.
+     */
+    bool isValid() const { return _valid; }
+
+    /**
+     * Same as :cpp:expr:`PinnacleTouch::read(RelativeReport*, bool)`, but without checking the
+     * data mode. Only use this if `isValid()` returns ``true``.
+     */
+    void read(RelativeReport* report)
+    {
+        uint8_t buffer[4 - SKIP];
+        _trackpad.readPacket(pinnacle_registers::PacketByte0::address + SKIP, buffer, 3 - SKIP + Intellimouse);
+        PinnacleTouch::unpackReport(report, buffer, ReadButtons, Intellimouse);
+    }
+
+    /**
+     * Same as `read()`, but also get the time at which the data became available. See
+     * :cpp:expr:`PinnacleTouch::readTimestamped(RelativeReport*, uint64_t*, bool)` for details.
+     */
+    void readTimestamped(RelativeReport* report, uint64_t* timestamp)
+    {
+        *timestamp = _trackpad.dataReadyTimestamp();
+        read(report);
+    }
+
+    // a Relative mode handle can't read absolute data
+    void read(AbsoluteReport* report) = delete;
+    void readTimestamped(AbsoluteReport* report, uint64_t* timestamp) = delete;
+
+private:
+    friend class PinnacleTouchStatic<Transport>;
+    PinnacleRelativeHandle(PinnacleTouchStatic<Transport>& trackpad)
+        : _trackpad(trackpad), _valid(trackpad._dataMode == PINNACLE_RELATIVE && trackpad._intellimouse == Intellimouse) {}
+    enum { SKIP = ReadButtons ? 0 : 1 }; // the number of packet bytes not read
+    PinnacleTouchStatic<Transport>& _trackpad;
+    bool _valid;
 };
 
 /**
@@ -849,7 +1617,7 @@ protected:
  *
  * @ingroup pinnacle-touch-api
  */
-class PinnacleTouchSPI : public PinnacleTouch
+class PinnacleTouchSPI : public PinnacleTouchStatic<PinnacleTouchSPI>
 {
 public:
     /**
@@ -868,6 +1636,10 @@ public:
     /**
      * Starts the driver interface on the appropriate SPI bus.
      *
+     * On Linux, each trackpad opens its own spidev device (specified by the ``slaveSelectPin``
+     * given to the constructor). So, trackpads on separate devices can be used from separate
+     * threads at the same time.
+     *
      * @returns The same value as `PinnacleTouch::begin()`.
      */
     bool begin();
@@ -883,6 +1655,29 @@ public:
      * @id pinnacle_spi_t
      */
     bool begin(pinnacle_spi_t* spi_bus);
+    /**
+     * Same as `begin()`, but the trackpad is ready sooner (see `PinnacleTouch::fastBegin()`).
+     *
+     * @param snapshot A configuration captured with `PinnacleTouch::getConfigSnapshot()`.
+     *     If given, it is restored instead of calibrating the trackpad again.
+     *
+     * @returns The same value as `PinnacleTouch::begin()`.
+     */
+    bool fastBegin(const PinnacleConfigSnapshot* snapshot = nullptr);
+    /**
+     * Same as :cpp:expr:`begin(pinnacle_spi_t*)`, but the trackpad is ready sooner
+     * (see `PinnacleTouch::fastBegin()`).
+     *
+     * @param spi_bus A reference to the instantiated object that corresponds to
+     *     a specific SPI bus.
+     * @param snapshot A configuration captured with `PinnacleTouch::getConfigSnapshot()`.
+     *     If given, it is restored instead of calibrating the trackpad again.
+     *
+     * @returns The same value as `PinnacleTouch::begin()`.
+     *
+     * @id pinnacle_spi_t_snapshot
+     */
+    bool fastBegin(pinnacle_spi_t* spi_bus, const PinnacleConfigSnapshot* snapshot = nullptr);
 
 private:
     void rapWriteCmd(uint8_t*, uint8_t);
@@ -890,9 +1685,29 @@ private:
     void rapWriteBytes(uint8_t, uint8_t*, uint8_t);
     void rapRead(uint8_t, uint8_t*);
     void rapReadBytes(uint8_t, uint8_t*, uint8_t);
+    void rapReadPacket(uint8_t, uint8_t*, uint8_t);
+    void rapSubmit(const RapOperation*, uint8_t);
+    const void* busObject() const;
+    friend class PinnacleTouchStatic<PinnacleTouchSPI>;
+    pinnacle_spi_t* startBus();
+    void useBus(pinnacle_spi_t*);
+#ifdef PINNACLE_BUS_LOCK
+    void lockBus();
+    void unlockBus();
+#endif
+#ifdef SPI_HAS_TRANSACTION
+    void beginBusTransaction();
+    void endBusTransaction();
+#endif
     const pinnacle_gpio_t _slaveSelect;
     const uint32_t _spiSpeed;
     pinnacle_spi_t* spi;
+#ifdef PINNACLE_USE_NATIVE_CS
+    pinnacle_spi_t _spiDevice; // the bus object opened by begin()
+#endif
+#ifdef PINNACLE_SPI_BUFFER_OPS
+    uint8_t _buffer[PINNACLE_SPI_BUFFER_SIZE];
+#endif
 };
 
 /**
@@ -900,7 +1715,7 @@ private:
  *
  * @ingroup pinnacle-touch-api
  */
-class PinnacleTouchI2C : public PinnacleTouch
+class PinnacleTouchI2C : public PinnacleTouchStatic<PinnacleTouchI2C>
 {
 public:
     /**
@@ -932,6 +1747,29 @@ public:
      * @id pinnacle_i2c_t
      */
     bool begin(pinnacle_i2c_t* i2c_bus);
+    /**
+     * Same as `begin()`, but the trackpad is ready sooner (see `PinnacleTouch::fastBegin()`).
+     *
+     * @param snapshot A configuration captured with `PinnacleTouch::getConfigSnapshot()`.
+     *     If given, it is restored instead of calibrating the trackpad again.
+     *
+     * @returns The same value as `PinnacleTouch::begin()`.
+     */
+    bool fastBegin(const PinnacleConfigSnapshot* snapshot = nullptr);
+    /**
+     * Same as :cpp:expr:`begin(pinnacle_i2c_t*)`, but the trackpad is ready sooner
+     * (see `PinnacleTouch::fastBegin()`).
+     *
+     * @param i2c_bus A reference to the instantiated object that corresponds to
+     *     a specific I2C bus.
+     * @param snapshot A configuration captured with `PinnacleTouch::getConfigSnapshot()`.
+     *     If given, it is restored instead of calibrating the trackpad again.
+     *
+     * @returns The same value as `PinnacleTouch::begin()`.
+     *
+     * @id pinnacle_i2c_t_snapshot
+     */
+    bool fastBegin(pinnacle_i2c_t* i2c_bus, const PinnacleConfigSnapshot* snapshot = nullptr);
 
 private:
     void rapWriteCmd(uint8_t*, uint8_t);
@@ -939,6 +1777,15 @@ private:
     void rapWriteBytes(uint8_t, uint8_t*, uint8_t);
     void rapRead(uint8_t, uint8_t*);
     void rapReadBytes(uint8_t, uint8_t*, uint8_t);
+    void rapReadPacket(uint8_t, uint8_t*, uint8_t);
+    void rapSubmit(const RapOperation*, uint8_t);
+    const void* busObject() const;
+    friend class PinnacleTouchStatic<PinnacleTouchI2C>;
+    pinnacle_i2c_t* startBus();
+#ifdef PINNACLE_BUS_LOCK
+    void lockBus();
+    void unlockBus();
+#endif
     const uint8_t _slaveAddress;
     pinnacle_i2c_t* i2c;
 };
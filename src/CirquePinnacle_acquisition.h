@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _CIRQUEPINNACLE_ACQUISITION_H_
+#define _CIRQUEPINNACLE_ACQUISITION_H_
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include "CirquePinnacle.h"
+
+#ifndef PINNACLE_ACQUISITION_WAIT_MS
+    /**
+     * The longest time (in milliseconds) that the acquisition thread waits on the Data Ready pin
+     * before checking if it was asked to stop. This only limits how long
+     * `PinnacleAcquisition::stop()` can take; it does not affect the latency of reports.
+     *
+     * @ingroup acquisition-api
+     */
+    #define PINNACLE_ACQUISITION_WAIT_MS 20
+#endif
+
+/**
+ * The behavior of a `PinnacleReportRing` when a report is pushed into a full ring.
+ *
+ * @ingroup acquisition-api
+ */
+enum PinnacleOverflowMode : uint8_t
+{
+    /** Discard the oldest report in the ring to make room for the newest report. */
+    PINNACLE_OVERFLOW_OVERWRITE = 0x00,
+    /** Discard the newest report and keep the reports already in the ring. */
+    PINNACLE_OVERFLOW_DROP = 0x01,
+};
+
+/**
+ * A data report paired with the time that the Pinnacle asserted its Data Ready pin.
+ *
+ * @tparam ReportT Either `RelativeReport` or `AbsoluteReport`.
+ *
+ * @ingroup acquisition-api
+ */
+template<typename ReportT>
+struct PinnacleTimedReport
+{
+    /** The data report. */
+    ReportT report;
+    /**
+     * The time (in nanoseconds) that the report was made available.
+     * See :cpp:func:`PinnacleTouch::readTimestamped()` for details.
+     */
+    uint64_t timestamp = 0;
+};
+
+/**
+ * A fixed-capacity, lock-free ring buffer with exactly one producer thread and one consumer
+ * thread.
+ *
+ * Neither thread ever blocks or allocates memory. A full ring either discards its oldest item or
+ * the new item, depending on the `PinnacleOverflowMode`; every discarded item is counted by
+ * `dropped()`.
+ *
+ * @tparam T The type of item stored. This must be trivially copyable.
+ * @tparam Capacity The number of items the ring can hold. This must be a power of 2.
+ *
+ * @ingroup acquisition-api
+ */
+template<typename T, uint32_t Capacity>
+class PinnacleReportRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(std::is_trivially_copyable<T>::value, "Items must be trivially copyable");
+
+public:
+    /**
+     * Create an empty ring.
+     *
+     * @param mode The initial `PinnacleOverflowMode`.
+     */
+    PinnacleReportRing(PinnacleOverflowMode mode = PINNACLE_OVERFLOW_OVERWRITE)
+        : _head(0), _tail(0), _dropped(0), _mode(mode)
+    {
+        for (uint32_t i = 0; i < Capacity * WordCount; ++i)
+            _words[i].store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Add an item to the ring. This must only be called from the producer thread.
+     *
+     * @returns ``false`` if an item (either the oldest or the given ``item``) was discarded
+     *     because the ring was full. Otherwise ``true``.
+     */
+    bool push(const T& item)
+    {
+        bool lossless = true;
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) {
+            if (_mode.load(std::memory_order_relaxed) == PINNACLE_OVERFLOW_DROP) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            // The consumer may be popping the oldest item right now. If it wins, there is room.
+            if (_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                lossless = false;
+            }
+        }
+        uint32_t buffer[WordCount] = {0};
+        memcpy(buffer, &item, sizeof(T));
+        std::atomic<uint32_t>* slot = _words + (head & (Capacity - 1)) * WordCount;
+        for (uint8_t i = 0; i < WordCount; ++i)
+            slot[i].store(buffer[i], std::memory_order_relaxed);
+        _head.store(head + 1, std::memory_order_release);
+        return lossless;
+    }
+
+    /**
+     * Take the oldest item out of the ring. This must only be called from the consumer thread.
+     *
+     * @param[out] item The object that the oldest item is copied to.
+     *
+     * @returns ``true`` if an item was copied to ``item``. ``false`` if the ring was empty.
+     */
+    bool pop(T* item)
+    {
+        uint32_t buffer[WordCount];
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        do {
+            if (tail == _head.load(std::memory_order_acquire))
+                return false;
+            const std::atomic<uint32_t>* slot = _words + (tail & (Capacity - 1)) * WordCount;
+            for (uint8_t i = 0; i < WordCount; ++i)
+                buffer[i] = slot[i].load(std::memory_order_relaxed);
+            // If the producer discarded this item while it was being copied, the copy may be torn.
+            // The exchange fails in that case, and the next oldest item is copied instead.
+        } while (!_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+        memcpy(item, buffer, sizeof(T));
+        return true;
+    }
+
+    /** @returns The number of items in the ring. */
+    uint32_t size() const
+    {
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        return _head.load(std::memory_order_acquire) - tail;
+    }
+
+    /** @returns The total number of items discarded because the ring was full. */
+    uint32_t dropped() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the behavior used when an item is pushed into a full ring.
+     * This can be called from either thread.
+     */
+    void setOverflowMode(PinnacleOverflowMode mode)
+    {
+        _mode.store(mode, std::memory_order_relaxed);
+    }
+
+    /** @returns The behavior used when an item is pushed into a full ring. */
+    PinnacleOverflowMode getOverflowMode() const
+    {
+        return static_cast<PinnacleOverflowMode>(_mode.load(std::memory_order_relaxed));
+    }
+
+private:
+    static const uint8_t WordCount = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    // Items are stored as atomic words because the producer may overwrite the oldest item while
+    // the consumer copies it; the exchange on `_tail` decides if the copy is kept.
+    std::atomic<uint32_t> _words[Capacity * WordCount];
+    // both indices increment freely (wrapping at 2^32); only the lower bits select a slot
+    std::atomic<uint32_t> _head; // next slot to write; only changed by the producer
+    std::atomic<uint32_t> _tail; // next slot to read; the producer advances it when overwriting
+    std::atomic<uint32_t> _dropped;
+    std::atomic<uint8_t> _mode;
+
+    // lets the tests start the indices close to wrapping
+    friend struct PinnacleAcquisitionTest;
+};
+
+/**
+ * A single "latest value" slot that one writer thread publishes to and any number of reader
+ * threads take consistent snapshots from.
+ *
+ * The value is double-buffered: the writer fills the buffer that readers are not using, then
+ * flips an index to publish it. The writer never waits for readers, and readers never wait for
+ * the writer (even if the writer is preempted in the middle of `publish()`). A reader only
+ * retries its copy if the writer finished a value and started the next one while the reader
+ * was copying, so readers are lock-free but not wait-free.
+ *
+ * @tparam T The type of value stored. This must be trivially copyable.
+ *
+ * @ingroup acquisition-api
+ */
+template<typename T>
+class PinnacleReportSnapshot
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Values must be trivially copyable");
+
+public:
+    PinnacleReportSnapshot() : _sequence(0), _started(0)
+    {
+        for (uint8_t i = 0; i < WordCount * 2; ++i)
+            _words[i].store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Replace the stored value. This must only be called from the writer thread.
+     */
+    void publish(const T& value)
+    {
+        uint32_t buffer[WordCount] = {0};
+        memcpy(buffer, &value, sizeof(T));
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed) + 1;
+        // 0 means "never published"; skip to 2 so the buffers keep alternating
+        if (!sequence)
+            sequence = 2;
+        // tells readers of the buffer being overwritten that their copy may be torn
+        _started.store(sequence, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic<uint32_t>* words = _words + (sequence & 1) * WordCount;
+        for (uint8_t i = 0; i < WordCount; ++i)
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        _sequence.store(sequence, std::memory_order_release);
+    }
+
+    /**
+     * Copy the most recently published value. This can be called from any number of threads.
+     *
+     * @param[out] value The object that the stored value is copied to.
+     * @param[out] sequence The number of values published before (and including) the copied value.
+     *     Comparing this with a previous result tells how many values were missed. This
+     *     counter wraps around after 2\ :sup:`32` values (skipping 0). This parameter is optional.
+     *
+     * @returns ``true`` if a value was copied to ``value``. ``false`` if nothing was published yet.
+     */
+    bool load(T* value, uint32_t* sequence = nullptr) const
+    {
+        uint32_t buffer[WordCount];
+        uint32_t current, started;
+        do {
+            current = _sequence.load(std::memory_order_acquire);
+            if (!current)
+                return false;
+            const std::atomic<uint32_t>* words = _words + (current & 1) * WordCount;
+            for (uint8_t i = 0; i < WordCount; ++i)
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // the copied buffer is only overwritten by the value after the next one
+            started = _started.load(std::memory_order_relaxed);
+        } while (started - current > 1);
+        memcpy(value, buffer, sizeof(T));
+        if (sequence != nullptr)
+            *sequence = current;
+        return true;
+    }
+
+    /** @returns The number of values published so far. */
+    uint32_t sequence() const
+    {
+        return _sequence.load(std::memory_order_acquire);
+    }
+
+private:
+    static const uint8_t WordCount = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    // The values are stored as atomic words so that a reader racing the writer is well defined;
+    // the sequence numbers decide if the copy is kept.
+    std::atomic<uint32_t> _words[WordCount * 2];
+    std::atomic<uint32_t> _sequence; // the last value published; selects the buffer to read
+    std::atomic<uint32_t> _started;  // the last value that the writer started to store
+
+    // lets the tests start the sequence close to wrapping
+    friend struct PinnacleAcquisitionTest;
+};
+
+/**
+ * Read data reports from a `PinnacleTouch` on a dedicated thread.
+ *
+ * The thread waits for the Data Ready pin (see :cpp:func:`PinnacleTouch::waitAvailable()`), reads
+ * each report with :cpp:func:`PinnacleTouch::readTimestamped()`, and pushes it into a
+ * `PinnacleReportRing`. The application thread then takes reports out of the ring with `pop()`,
+ * which never blocks on bus I/O.
+ *
+ * Each report is also published to a `PinnacleReportSnapshot`. Threads that only want the most
+ * recent report can call `latest()` instead of `pop()`; any number of threads can do so at once.
+ *
+ * .. warning::
+ *     While the acquisition thread is running, it owns the ``trackpad``. Do not call any
+ *     ``trackpad`` methods from other threads until `stop()` returns.
+ *
+ * .. note:: This is only available on platforms that support ``std::thread`` (like Linux).
+ *
+ * @tparam ReportT Either `RelativeReport` or `AbsoluteReport`. This should match the data mode
+ *     that the ``trackpad`` was configured for.
+ * @tparam Capacity The number of reports that can be queued. This must be a power of 2.
+ *
+ * @ingroup acquisition-api
+ */
+template<typename ReportT, uint32_t Capacity = 64>
+class PinnacleAcquisition
+{
+public:
+    /** The type of item returned by `pop()`. */
+    typedef PinnacleTimedReport<ReportT> Entry;
+
+    /**
+     * Create an acquisition engine for an initialized trackpad. The thread is not started
+     * until `start()` is called.
+     *
+     * @param trackpad The trackpad to read. This object must outlive the acquisition engine.
+     * @param mode The `PinnacleOverflowMode` used when the application does not `pop()` reports
+     *     as fast as they are produced.
+     */
+    PinnacleAcquisition(PinnacleTouch* trackpad, PinnacleOverflowMode mode = PINNACLE_OVERFLOW_OVERWRITE)
+        : _trackpad(trackpad), _ring(mode), _running(false)
+    {
+    }
+
+    /** Stops the acquisition thread (if it is running). */
+    ~PinnacleAcquisition()
+    {
+        _running.store(false, std::memory_order_relaxed);
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    /**
+     * Start the acquisition thread. This does nothing if the thread was already started and
+     * `stop()` has not been called since.
+     *
+     * .. note:: Creating the thread allocates its state on the heap. Nothing else in this class
+     *     allocates memory.
+     */
+    void start()
+    {
+        if (_thread.joinable())
+            return;
+        _error = nullptr;
+        _running.store(true, std::memory_order_relaxed);
+        _thread = std::thread(&PinnacleAcquisition::run, this);
+    }
+
+    /**
+     * Stop the acquisition thread and wait for it to exit. Reports already in the ring can
+     * still be taken out with `pop()`.
+     *
+     * @throws If the acquisition thread stopped because of an exception (from the bus or GPIO
+     *     drivers), then that exception is re-thrown here.
+     */
+    void stop()
+    {
+        _running.store(false, std::memory_order_relaxed);
+        if (_thread.joinable())
+            _thread.join();
+        if (_error) {
+            std::exception_ptr error = _error;
+            _error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @returns ``true`` if the acquisition thread is running. This becomes ``false`` if
+     *     the thread exits because of an exception; call `stop()` to get the exception.
+     */
+    bool isRunning() const
+    {
+        return _running.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Take the oldest report out of the queue. This never blocks.
+     *
+     * @param[out] entry The object that the oldest report (and its timestamp) is copied to.
+     *
+     * @returns ``true`` if a report was copied to ``entry``. ``false`` if no reports are queued.
+     */
+    bool pop(Entry* entry)
+    {
+        return _ring.pop(entry);
+    }
+
+    /**
+     * Copy the most recent report. Unlike `pop()`, this does not take the report out of the
+     * queue, and it can be called from any number of threads.
+     *
+     * @param[out] entry The object that the most recent report (and its timestamp) is copied to.
+     * @param[out] sequence The number of reports read before (and including) the copied report.
+     *     This parameter is optional.
+     *
+     * @returns ``true`` if a report was copied to ``entry``. ``false`` if no reports were read yet.
+     */
+    bool latest(Entry* entry, uint32_t* sequence = nullptr) const
+    {
+        return _snapshot.load(entry, sequence);
+    }
+
+    /** @returns The number of reports waiting to be taken with `pop()`. */
+    uint32_t size() const
+    {
+        return _ring.size();
+    }
+
+    /** @returns The total number of reports discarded because the queue was full. */
+    uint32_t dropped() const
+    {
+        return _ring.dropped();
+    }
+
+    /** Set the `PinnacleOverflowMode` used when the queue is full. */
+    void setOverflowMode(PinnacleOverflowMode mode)
+    {
+        _ring.setOverflowMode(mode);
+    }
+
+    /** @returns The `PinnacleOverflowMode` used when the queue is full. */
+    PinnacleOverflowMode getOverflowMode() const
+    {
+        return _ring.getOverflowMode();
+    }
+
+private:
+    void run()
+    {
+        Entry entry;
+        try {
+            while (_running.load(std::memory_order_relaxed)) {
+                if (_trackpad->waitAvailable(PINNACLE_ACQUISITION_WAIT_MS)) {
+                    _trackpad->readTimestamped(&entry.report, &entry.timestamp);
+                    _snapshot.publish(entry);
+                    _ring.push(entry);
+                }
+            }
+        }
+        catch (...) {
+            _error = std::current_exception();
+            _running.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    PinnacleTouch* _trackpad;
+    PinnacleReportRing<Entry, Capacity> _ring;
+    PinnacleReportSnapshot<Entry> _snapshot;
+    std::thread _thread;
+    std::atomic<bool> _running;
+    // only written by the acquisition thread; only read after joining it
+    std::exception_ptr _error;
+};
+
+#endif // _CIRQUEPINNACLE_ACQUISITION_H_
@@ -34,6 +34,23 @@
     #define PINNACLE_ANYMEAS_SUPPORT true
 #endif // !defined(PINNACLE_ANYMEAS_SUPPORT)
 
+#ifndef PINNACLE_SPI_BURST_WRITES
+    /**
+     * This will send writes to consecutive registers over SPI as address/value pairs in a
+     * single chip-select frame (instead of 1 frame per register).
+     *
+     * @note
+     *     If the SPI bus is shared with devices that need to access it between register writes,
+     *     define this as ``false`` to fall back to writing 1 register per chip-select frame.
+     *
+     *     All builds using CMake (including the python bindings) can simply define
+     *     ``-D PINNACLE_SPI_BURST_WRITES=OFF`` as a CMake option.
+     *
+     * @ingroup cmake-options
+     */
+    #define PINNACLE_SPI_BURST_WRITES true
+#endif // !defined(PINNACLE_SPI_BURST_WRITES)
+
 #if defined(ARDUINO)
     #include <Arduino.h>
     #include <SPI.h>
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "CirquePinnacle_manager.h"
+// The manager needs a driver that exposes the Data Ready pin's edge events (Linux only)
+#ifdef PINNACLE_GPIO_EDGE_EVENTS
+    #include <unistd.h>    // close()
+    #include <sys/epoll.h> // epoll_create1(), epoll_ctl(), epoll_wait()
+    #include <errno.h>     // errno
+    #include <stdio.h>     // snprintf()
+    #include <string.h>    // strerror()
+
+using namespace cirque_pinnacle_arduino_wrappers;
+
+[[noreturn]] static void throwManagerException(const char* prefix, int error)
+{
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s; %s", prefix, strerror(error));
+    throw GPIOException(msg);
+}
+
+PinnacleTouchManager::PinnacleTouchManager()
+    : _epollFd(epoll_create1(EPOLL_CLOEXEC)), _count(0)
+{
+    if (_epollFd < 0) {
+        throwManagerException("[PinnacleTouchManager] Can't create epoll set", errno);
+    }
+    for (uint8_t i = 0; i < PINNACLE_MANAGER_MAX_TRACKPADS; ++i) {
+        _slots[i].trackpad = nullptr;
+    }
+}
+
+PinnacleTouchManager::~PinnacleTouchManager()
+{
+    ::close(_epollFd); // also removes all registered pins from the set
+}
+
+bool PinnacleTouchManager::add(PinnacleTouch* trackpad, PinnacleEventHandler handler, void* context)
+{
+    uint8_t index = PINNACLE_MANAGER_MAX_TRACKPADS;
+    for (uint8_t i = 0; i < PINNACLE_MANAGER_MAX_TRACKPADS; ++i) {
+        if (_slots[i].trackpad == trackpad) {
+            return false;
+        }
+        if (!_slots[i].trackpad && index == PINNACLE_MANAGER_MAX_TRACKPADS) {
+            index = i;
+        }
+    }
+    if (index == PINNACLE_MANAGER_MAX_TRACKPADS) {
+        return false;
+    }
+
+    int fd = GPIOClass::edgeFd(trackpad->dataReadyPin());
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u32 = index;
+    if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        throwManagerException("[PinnacleTouchManager::add] Can't add Data Ready pin to epoll set", errno);
+    }
+    _slots[index].trackpad = trackpad;
+    _slots[index].handler = handler;
+    _slots[index].context = context;
+    _slots[index].fd = fd;
+    ++_count;
+
+    // Only rising edges are waited for. If data is already pending, then discard it so that the
+    // next report raises the Data Ready pin again.
+    GPIOClass::clearEdges(trackpad->dataReadyPin());
+    if (trackpad->available()) {
+        trackpad->clearStatusFlags();
+    }
+    return true;
+}
+
+bool PinnacleTouchManager::remove(PinnacleTouch* trackpad)
+{
+    for (uint8_t i = 0; i < PINNACLE_MANAGER_MAX_TRACKPADS; ++i) {
+        if (_slots[i].trackpad == trackpad && trackpad) {
+            // this fails harmlessly if the pin was closed already (epoll forgets closed file descriptors)
+            epoll_ctl(_epollFd, EPOLL_CTL_DEL, _slots[i].fd, nullptr);
+            _slots[i].trackpad = nullptr;
+            --_count;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t PinnacleTouchManager::count() const
+{
+    return _count;
+}
+
+uint8_t PinnacleTouchManager::poll(int timeout)
+{
+    struct epoll_event events[PINNACLE_MANAGER_MAX_TRACKPADS];
+    int ready = epoll_wait(_epollFd, events, PINNACLE_MANAGER_MAX_TRACKPADS, timeout);
+    if (ready == -1) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        throwManagerException("[PinnacleTouchManager::poll] Can't wait on epoll set", errno);
+    }
+
+    // sort the fired trackpads by bus, so trackpads that share a bus are adjacent
+    // (insertion sort; there are only a few)
+    Slot* fired[PINNACLE_MANAGER_MAX_TRACKPADS];
+    uint8_t firedCount = 0;
+    for (int i = 0; i < ready; ++i) {
+        Slot* slot = &_slots[events[i].data.u32];
+        if (!slot->trackpad) {
+            continue; // removed by a handler during a previous poll()
+        }
+        uintptr_t bus = (uintptr_t)slot->trackpad->busObject();
+        uint8_t j = firedCount++;
+        for (; j > 0 && (uintptr_t)fired[j - 1]->trackpad->busObject() > bus; --j) {
+            fired[j] = fired[j - 1];
+        }
+        fired[j] = slot;
+    }
+
+    // Read the trackpads on each bus while holding 1 session for the whole run, so the bus is
+    // locked once per run instead of once per trackpad.
+    PinnacleTouchEvent reports[PINNACLE_MANAGER_MAX_TRACKPADS];
+    Slot* readSlots[PINNACLE_MANAGER_MAX_TRACKPADS];
+    uint8_t readCount = 0;
+    for (uint8_t i = 0; i < firedCount;) {
+        const void* bus = fired[i]->trackpad->busObject();
+        PinnacleTouch::BusSession session(fired[i]->trackpad);
+        for (; i < firedCount && fired[i]->trackpad->busObject() == bus; ++i) {
+            if (read(*fired[i], &reports[readCount])) {
+                readSlots[readCount++] = fired[i];
+            }
+        }
+    }
+
+    // handlers are called after all buses are released
+    uint8_t dispatched = 0;
+    for (uint8_t i = 0; i < readCount; ++i) {
+        // a handler may have removed (or replaced) a trackpad that was read
+        if (readSlots[i]->trackpad == reports[i].trackpad) {
+            readSlots[i]->handler(reports[i], readSlots[i]->context);
+            ++dispatched;
+        }
+    }
+    return dispatched;
+}
+
+bool PinnacleTouchManager::read(Slot& slot, PinnacleTouchEvent* event)
+{
+    PinnacleTouch* trackpad = slot.trackpad;
+    event->trackpad = trackpad;
+    event->mode = trackpad->getDataMode();
+
+    // A rising edge is always new data (same as PinnacleTouch::waitAvailable()), unless the
+    // data was discarded since. The edge is consumed by readTimestamped().
+    trackpad->edgeConsumed();
+    if (!trackpad->available()) {
+        GPIOClass::clearEdges(trackpad->dataReadyPin());
+        return false;
+    }
+    if (event->mode == PINNACLE_ABSOLUTE) {
+        trackpad->readTimestamped(&event->absolute, &event->timestamp);
+    }
+    else if (event->mode == PINNACLE_RELATIVE) {
+        trackpad->readTimestamped(&event->relative, &event->timestamp);
+    }
+    else { // other modes don't produce reports
+        GPIOClass::clearEdges(trackpad->dataReadyPin());
+        return false;
+    }
+    return true;
+}
+
+#endif // defined(PINNACLE_GPIO_EDGE_EVENTS)
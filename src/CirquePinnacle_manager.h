@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _CIRQUEPINNACLE_MANAGER_H_
+#define _CIRQUEPINNACLE_MANAGER_H_
+#include <stdint.h>
+#include "CirquePinnacle.h"
+
+#ifndef PINNACLE_MANAGER_MAX_TRACKPADS
+    /**
+     * The maximum number of trackpads that a `PinnacleTouchManager` can serve.
+     *
+     * @ingroup manager-api
+     */
+    #define PINNACLE_MANAGER_MAX_TRACKPADS 16
+#endif
+
+/**
+ * The data passed to a `PinnacleEventHandler` when a trackpad reports new data.
+ *
+ * @ingroup manager-api
+ */
+struct PinnacleTouchEvent
+{
+    /** The trackpad that reported new data. */
+    PinnacleTouch* trackpad = nullptr;
+    /**
+     * The trackpad's data mode. This tells which of `relative` or `absolute` holds the new data.
+     */
+    PinnacleDataMode mode = PINNACLE_RELATIVE;
+    /**
+     * The time (in nanoseconds) that the report was made available.
+     * See :cpp:func:`PinnacleTouch::readTimestamped()` for details.
+     */
+    uint64_t timestamp = 0;
+    /** The new data if `mode` is `PINNACLE_RELATIVE`. */
+    RelativeReport relative;
+    /** The new data if `mode` is `PINNACLE_ABSOLUTE`. */
+    AbsoluteReport absolute;
+};
+
+/**
+ * The type of function called by `PinnacleTouchManager::poll()` for each report.
+ *
+ * @param event The trackpad and the data it reported.
+ * @param context The pointer that was given to `PinnacleTouchManager::add()`.
+ *
+ * @ingroup manager-api
+ */
+typedef void (*PinnacleEventHandler)(const PinnacleTouchEvent& event, void* context);
+
+/**
+ * Serve several trackpads from one thread.
+ *
+ * All registered trackpads' Data Ready pins are waited on with a single ``epoll`` set, so the
+ * thread sleeps until at least one trackpad has new data. Only the trackpads that reported new
+ * data are read. Reads are grouped by bus: the trackpads that share a bus are read while holding
+ * 1 :cpp:class:`PinnacleTouch::BusSession`, so the bus is locked once for all of them. The event
+ * handlers are called after all reads are done, when no bus is held.
+ *
+ * .. note::
+ *     Only I2C trackpads are grouped this way (when they share a
+ *     `~cirque_pinnacle_arduino_wrappers::TwoWire` object). Each SPI trackpad uses its own
+ *     ``/dev/spidevX.Y`` device (the chip select line is part of the device), so it has its own
+ *     `~cirque_pinnacle_arduino_wrappers::SPIClass` object and is read in a session of its own.
+ *     The kernel serializes the transfers of devices on the same SPI controller.
+ *
+ * Only trackpads in Relative or Absolute mode are read. Data Ready signals from trackpads in
+ * any other mode are discarded.
+ *
+ * .. warning::
+ *     Once a trackpad is registered, only call its methods from the thread that calls
+ *     `poll()`.
+ *
+ * .. note:: This is only available on Linux.
+ *
+ * @ingroup manager-api
+ */
+class PinnacleTouchManager
+{
+public:
+    /**
+     * Create a manager with no trackpads registered.
+     *
+     * @throws GPIOException if the ``epoll`` set could not be created.
+     */
+    PinnacleTouchManager();
+    ~PinnacleTouchManager();
+    PinnacleTouchManager(const PinnacleTouchManager&) = delete;
+    PinnacleTouchManager& operator=(const PinnacleTouchManager&) = delete;
+
+    /**
+     * Register a trackpad.
+     *
+     * @param trackpad An initialized trackpad (:cpp:func:`~PinnacleTouchSPI::begin()` or
+     *     :cpp:func:`~PinnacleTouchI2C::begin()` must have returned ``true``). This object must
+     *     outlive its registration.
+     * @param handler The function called for each report from the ``trackpad``.
+     * @param context An optional pointer passed to the ``handler``.
+     *
+     * @returns ``false`` if the ``trackpad`` is already registered or `PINNACLE_MANAGER_MAX_TRACKPADS`
+     *     trackpads are registered. Otherwise ``true``.
+     *
+     * @throws GPIOException if the trackpad's Data Ready pin could not be added to the
+     *     ``epoll`` set.
+     */
+    bool add(PinnacleTouch* trackpad, PinnacleEventHandler handler, void* context = nullptr);
+
+    /**
+     * Unregister a trackpad.
+     *
+     * @returns ``false`` if the ``trackpad`` was not registered. Otherwise ``true``.
+     */
+    bool remove(PinnacleTouch* trackpad);
+
+    /** @returns The number of registered trackpads. */
+    uint8_t count() const;
+
+    /**
+     * Wait for any registered trackpad to report new data, then read and dispatch the
+     * reports of all trackpads that have new data.
+     *
+     * @param timeout The maximum number of milliseconds to wait. Use ``-1`` to wait forever.
+     *
+     * @returns The number of reports dispatched. This is ``0`` if the ``timeout`` expired (or
+     *     the wait was interrupted by a signal).
+     *
+     * @throws GPIOException if waiting on the ``epoll`` set failed. Exceptions from the bus
+     *     drivers and the event handlers are also propagated.
+     */
+    uint8_t poll(int timeout);
+
+private:
+    struct Slot
+    {
+        PinnacleTouch* trackpad;
+        PinnacleEventHandler handler;
+        void* context;
+        int fd; // the Data Ready pin's edge events
+    };
+    // read a fired trackpad's report; returns false if it had no report
+    bool read(Slot& slot, PinnacleTouchEvent* event);
+    int _epollFd;
+    uint8_t _count;
+    Slot _slots[PINNACLE_MANAGER_MAX_TRACKPADS]; // unused slots have a null trackpad
+};
+
+#endif // _CIRQUEPINNACLE_MANAGER_H_
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _CIRQUEPINNACLE_REGISTERS_H_
+#define _CIRQUEPINNACLE_REGISTERS_H_
+#include <stdint.h>
+
+/*
+ * A compile-time description of the Pinnacle's registers and their bit fields.
+ *
+ * Setting a field produces a `PinnacleRegisterUpdate` (a mask and the masked value). Updates of
+ * the same register are merged with `|`; merging updates of different registers does not
+ * compile. An update that covers all 8 bits (see `PinnacleRegisterUpdate::whole()`) is
+ * written without reading the register first.
+ *
+ * This is only C++11 (single statement constexpr functions).
+ */
+
+/* How a register is accessed. */
+enum PinnacleRegisterAccess : uint8_t
+{
+    PINNACLE_RAP_ACCESS, // Register Access Protocol (directly addressed)
+    PINNACLE_ERA_ACCESS, // Extended Register Access (addressed through the ERA registers)
+};
+
+template <uint16_t Address, PinnacleRegisterAccess Access = PINNACLE_RAP_ACCESS>
+struct PinnacleRegister
+{
+    static constexpr uint16_t address = Address;
+    static constexpr PinnacleRegisterAccess access = Access;
+};
+
+template <uint16_t Address, PinnacleRegisterAccess Access>
+constexpr uint16_t PinnacleRegister<Address, Access>::address;
+template <uint16_t Address, PinnacleRegisterAccess Access>
+constexpr PinnacleRegisterAccess PinnacleRegister<Address, Access>::access;
+
+/* A change to some bits of a `Register`. */
+template <class Register>
+struct PinnacleRegisterUpdate
+{
+    uint8_t mask;  // the bits that are changed
+    uint8_t value; // the new values of the changed bits
+
+    // merge with a later update of the same register
+    constexpr PinnacleRegisterUpdate operator|(PinnacleRegisterUpdate later) const
+    {
+        return PinnacleRegisterUpdate{static_cast<uint8_t>(mask | later.mask),
+                                      static_cast<uint8_t>((value & ~later.mask) | later.value)};
+    }
+
+    // the same update, but all bits that are not changed are cleared
+    constexpr PinnacleRegisterUpdate whole() const
+    {
+        return PinnacleRegisterUpdate{0xFF, value};
+    }
+
+    // true if the register's current value is not needed
+    constexpr bool isWhole() const
+    {
+        return mask == 0xFF;
+    }
+
+    // the register's new value
+    constexpr uint8_t apply(uint8_t current) const
+    {
+        return static_cast<uint8_t>((current & ~mask) | value);
+    }
+};
+
+/* A field of `Width` bits that starts at bit `Offset` of a `Register`. */
+template <class Register, uint8_t Offset, uint8_t Width = 1>
+struct PinnacleField
+{
+    static_assert(Offset + Width <= 8, "a field must fit in 1 register");
+    static constexpr uint8_t mask = static_cast<uint8_t>(((1 << Width) - 1) << Offset);
+
+    static constexpr PinnacleRegisterUpdate<Register> set(unsigned int value)
+    {
+        return PinnacleRegisterUpdate<Register>{mask, static_cast<uint8_t>((value << Offset) & mask)};
+    }
+
+    static constexpr uint8_t get(uint8_t registerValue)
+    {
+        return static_cast<uint8_t>((registerValue & mask) >> Offset);
+    }
+};
+
+template <class Register, uint8_t Offset, uint8_t Width>
+constexpr uint8_t PinnacleField<Register, Offset, Width>::mask;
+
+/* The registers and fields used by the library */
+namespace pinnacle_registers {
+
+    typedef PinnacleRegister<0x00> FirmwareId; // 2 registers (ID and version)
+    typedef PinnacleRegister<0x02> Status;
+
+    typedef PinnacleRegister<0x03> SysConfig;
+    typedef PinnacleField<SysConfig, 0> Reset;
+    typedef PinnacleField<SysConfig, 1> Shutdown;
+    typedef PinnacleField<SysConfig, 2> AllowSleep;
+    typedef PinnacleField<SysConfig, 3, 2> AnyMeas; // 1 disables tracking; 0 for Relative/Absolute mode
+
+    typedef PinnacleRegister<0x04> FeedConfig1;
+    typedef PinnacleField<FeedConfig1, 0> FeedEnable;
+    typedef PinnacleField<FeedConfig1, 1> AbsoluteMode;
+    typedef PinnacleField<FeedConfig1, 6> InvertX;
+    typedef PinnacleField<FeedConfig1, 7> InvertY;
+
+    typedef PinnacleRegister<0x05> FeedConfig2;
+    typedef PinnacleField<FeedConfig2, 0> Intellimouse;
+    typedef PinnacleField<FeedConfig2, 1> TapsDisable;
+    typedef PinnacleField<FeedConfig2, 2> SecondaryTapDisable;
+    typedef PinnacleField<FeedConfig2, 4> GlideExtendDisable;
+    typedef PinnacleField<FeedConfig2, 7> Rotate90;
+
+    typedef PinnacleRegister<0x06> FeedConfig3;
+
+    typedef PinnacleRegister<0x07> CalConfig;
+    typedef PinnacleField<CalConfig, 0> CalibrateRun;
+    typedef PinnacleField<CalConfig, 1> BackgroundComp;
+    typedef PinnacleField<CalConfig, 2> NerdComp;
+    typedef PinnacleField<CalConfig, 3> TrackErrorComp;
+    typedef PinnacleField<CalConfig, 4> TapComp;
+
+    typedef PinnacleRegister<0x09> SampleRate;
+    typedef PinnacleRegister<0x0A> ZIdle;
+    typedef PinnacleRegister<0x0B> ZScaler;
+    typedef PinnacleRegister<0x0C> SleepInterval; // time of sleep until checking for finger
+    typedef PinnacleRegister<0x0D> SleepTimer;    // time after idle mode until sleep starts
+    typedef PinnacleRegister<0x12> PacketByte0;
+    typedef PinnacleRegister<0x13> PacketByte1;
+
+    typedef PinnacleRegister<0x1B> EraValue;
+    typedef PinnacleRegister<0x1C> EraAddr; // 2 registers (big endian)
+    typedef PinnacleRegister<0x1E> EraControl;
+
+    typedef PinnacleRegister<0x1F> HcoId;
+    typedef PinnacleField<HcoId, 7> HardConfigured;
+
+    typedef PinnacleRegister<0x00EB, PINNACLE_ERA_ACCESS> FingerStylus;
+    typedef PinnacleField<FingerStylus, 0> FingerDetect;
+    typedef PinnacleField<FingerStylus, 2> StylusDetect;
+
+    typedef PinnacleRegister<0x0149, PINNACLE_ERA_ACCESS> XAxisWideZMin;
+    typedef PinnacleRegister<0x0168, PINNACLE_ERA_ACCESS> YAxisWideZMin;
+
+    typedef PinnacleRegister<0x0187, PINNACLE_ERA_ACCESS> AdcConfig;
+    typedef PinnacleField<AdcConfig, 6, 2> AdcGain;
+
+    typedef PinnacleRegister<0x019E, PINNACLE_ERA_ACCESS> ReloadTimer; // 2 registers
+
+    typedef PinnacleRegister<0x01DF, PINNACLE_ERA_ACCESS> CalibrationMatrix; // 92 registers
+
+    // compile-time checks of the field model
+    static_assert(AnyMeas::mask == 0x18, "a field's mask covers its bits");
+    static_assert(AnyMeas::set(1).value == 0x08 && AnyMeas::set(1).mask == 0x18, "set() shifts the value into the field");
+    static_assert(AnyMeas::set(7).value == 0x18, "set() drops the bits that don't fit in the field");
+    static_assert(AnyMeas::get(0xFF) == 3 && AnyMeas::get(0xE7) == 0, "get() only extracts the field's bits");
+    static_assert(AdcGain::get(AdcGain::set(2).apply(0x3F)) == 2, "get() reverses set()");
+    static_assert(FeedEnable::set(1).apply(0xF0) == 0xF1 && FeedEnable::set(0).apply(0xFF) == 0xFE,
+                  "apply() only changes the field's bits");
+    static_assert((FeedEnable::set(1) | AbsoluteMode::set(1)).mask == 0x03, "merged updates change both fields");
+    static_assert((FeedEnable::set(1) | FeedEnable::set(0)).apply(0x01) == 0x00, "a later update wins");
+    static_assert((InvertX::set(1) | InvertY::set(0)).apply(0x80) == 0x40, "merged updates apply both fields");
+    static_assert(FeedEnable::set(1).whole().isWhole() && FeedEnable::set(1).whole().apply(0xFE) == 0x01,
+                  "whole() clears the bits that are not changed");
+    static_assert(!FeedEnable::set(1).isWhole(), "a partial update needs the register's current value");
+
+} // namespace pinnacle_registers
+
+#endif // _CIRQUEPINNACLE_REGISTERS_H_
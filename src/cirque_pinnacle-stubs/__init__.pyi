@@ -14,7 +14,7 @@
 # LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 # SOFTWARE.
-from typing import List, overload
+from typing import List, Optional, overload
 
 class PinnacleDataMode:
     @property
@@ -79,6 +79,24 @@ class AbsoluteReport:
         self.y: int = ...
         self.z: int = ...
 
+class PinnacleConfigSnapshot:
+    def __init__(self) -> None: ...
+    @property
+    def config(self) -> List[int]: ...
+    @config.setter
+    def config(self, config: List[int]) -> None: ...
+    @property
+    def calibration_matrix(self) -> List[int]: ...
+    @calibration_matrix.setter
+    def calibration_matrix(self, matrix: List[int]) -> None: ...
+    reload_timer: int
+    adc_config: int
+    x_axis_wide_z_min: int
+    y_axis_wide_z_min: int
+    finger_stylus: int
+    def serialize(self) -> bytes: ...
+    def deserialize(self, blob: bytes) -> bool: ...
+
 class PinnacleTouch:
     def __init__(self, data_ready_pin: int) -> None: ...
     @property
@@ -94,9 +112,17 @@ class PinnacleTouch:
     def feedEnabled(self, value: bool) -> None: ...
     def isFeedEnabled(self) -> bool: ...
     @property
+    def register_cache_enabled(self) -> bool: ...
+    @register_cache_enabled.setter
+    def register_cache_enabled(self, value: bool) -> None: ...
+    def registerCacheEnabled(self, value: bool) -> None: ...
+    def isRegisterCacheEnabled(self) -> bool: ...
+    @property
     def is_hard_configured(self) -> bool: ...
     def isHardConfigured(self) -> bool: ...
     def available(self) -> bool: ...
+    def wait_available(self, timeout: int) -> bool: ...
+    def waitAvailable(self, timeout: int) -> bool: ...
     def absolute_mode_config(
         self, z_idle_count: int = 30, invert_x: bool = False, invert_y: bool = False
     ) -> None: ...
@@ -123,6 +149,22 @@ class PinnacleTouch:
     def read(self, report: AbsoluteReport, read_buttons: bool = True) -> None: ...
     @overload
     def read(self, report: RelativeReport, read_buttons: bool = True) -> None: ...
+    @overload
+    def read_timestamped(
+        self, report: AbsoluteReport, read_buttons: bool = True
+    ) -> int: ...
+    @overload
+    def read_timestamped(
+        self, report: RelativeReport, read_buttons: bool = True
+    ) -> int: ...
+    @overload
+    def readTimestamped(
+        self, report: AbsoluteReport, read_buttons: bool = True
+    ) -> int: ...
+    @overload
+    def readTimestamped(
+        self, report: RelativeReport, read_buttons: bool = True
+    ) -> int: ...
     def clear_status_flags(self) -> None: ...
     def clearStatusFlags(self) -> None: ...
     @property
@@ -167,6 +209,18 @@ class PinnacleTouch:
     def calibration_matrix(self, buffer: List[int]) -> None: ...
     def getCalibrationMatrix(self) -> List[int]: ...
     def setCalibrationMatrix(self, matrix: List[int]) -> None: ...
+    def get_config_snapshot(self) -> PinnacleConfigSnapshot: ...
+    def getConfigSnapshot(self) -> PinnacleConfigSnapshot: ...
+    def set_config_snapshot(
+        self,
+        snapshot: PinnacleConfigSnapshot,
+        current: Optional[PinnacleConfigSnapshot] = None,
+    ) -> bool: ...
+    def setConfigSnapshot(
+        self,
+        snapshot: PinnacleConfigSnapshot,
+        current: Optional[PinnacleConfigSnapshot] = None,
+    ) -> bool: ...
     def set_adc_gain(self, sensitivity: int) -> None: ...
     def setAdcGain(self, sensitivity: int) -> None: ...
     def tune_edge_sensitivity(
@@ -203,6 +257,8 @@ class PinnacleTouch:
 class PinnacleTouchSPI(PinnacleTouch):
     def __init__(self, data_ready_pin: int, slave_select: int) -> None: ...
     def begin(self) -> bool: ...
+    def fast_begin(self, snapshot: Optional[PinnacleConfigSnapshot] = None) -> bool: ...
+    def fastBegin(self, snapshot: Optional[PinnacleConfigSnapshot] = None) -> bool: ...
 
 class TwoWire:
     def __init__(self) -> None: ...
@@ -214,6 +270,10 @@ class TwoWire:
     def requestFrom(self, register: int, quantity: int, sendStop: int) -> int: ...
     def available(self) -> int: ...
     def read(self) -> int: ...
+    def setProcessShared(self, enable: bool) -> None: ...
+    def isProcessShared(self) -> bool: ...
+    def lockCount(self) -> int: ...
+    def contentionCount(self) -> int: ...
 
 class PinnacleTouchI2C(PinnacleTouch):
     def __init__(self, data_ready_pin: int, slave_address: int = 0x2A) -> None: ...
@@ -221,3 +281,15 @@ class PinnacleTouchI2C(PinnacleTouch):
     def begin(self) -> bool: ...
     @overload
     def begin(self, i2C_bus: TwoWire) -> bool: ...
+    @overload
+    def fast_begin(self, snapshot: Optional[PinnacleConfigSnapshot] = None) -> bool: ...
+    @overload
+    def fast_begin(
+        self, i2c_bus: TwoWire, snapshot: Optional[PinnacleConfigSnapshot] = None
+    ) -> bool: ...
+    @overload
+    def fastBegin(self, snapshot: Optional[PinnacleConfigSnapshot] = None) -> bool: ...
+    @overload
+    def fastBegin(
+        self, i2c_bus: TwoWire, snapshot: Optional[PinnacleConfigSnapshot] = None
+    ) -> bool: ...
@@ -0,0 +1,65 @@
+# Fail the build if any of the library's object files reference a heap allocator.
+#
+# This script is run (in CMake's script mode) after the library is built:
+#   cmake -D NM=<path to nm> -D OBJECTS=<obj1|obj2|...> [-D EXCLUDE=<regex>] -P CheckNoHeap.cmake
+#
+# `OBJECTS` is a '|' separated list of object files.
+# Objects with a path that matches the `EXCLUDE` regular expression are not checked.
+#
+# Only direct calls to allocation functions fail the check.
+#
+# Throw paths are exempt: throwing an exception allocates the exception object
+# (`__cxa_allocate_exception`), and the bus/GPIO drivers build exception messages with
+# std::string (`basic_string::_M_create`). These allocations only happen when an error is
+# reported, never while the library works normally. Objects that reference these symbols are
+# listed as a status message, so the exemption is visible in the build output.
+
+if(NOT NM OR NOT OBJECTS)
+    message(FATAL_ERROR "CheckNoHeap.cmake requires the NM and OBJECTS variables")
+endif()
+
+set(HEAP_SYMBOLS_REGEX
+    "^(malloc|calloc|realloc|free|posix_memalign|aligned_alloc|strdup|_Znwm|_Znam|_Znwj|_Znaj|_ZnwmRKSt9nothrow_t|_ZnamRKSt9nothrow_t)$"
+)
+set(THROW_PATH_SYMBOLS_REGEX
+    "^(__cxa_allocate_exception|_ZNSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE9_M_create.*)$"
+)
+
+string(REPLACE "|" ";" OBJECTS "${OBJECTS}")
+set(violations "")
+set(exemptions "")
+foreach(object ${OBJECTS})
+    if(EXCLUDE AND object MATCHES "${EXCLUDE}")
+        continue()
+    endif()
+    execute_process(
+        COMMAND ${NM} --undefined-only --format=posix ${object}
+        OUTPUT_VARIABLE symbols
+        RESULT_VARIABLE nm_result
+    )
+    if(NOT nm_result EQUAL 0)
+        message(FATAL_ERROR "Failed to inspect ${object} with ${NM}")
+    endif()
+    string(REPLACE "\n" ";" symbols "${symbols}")
+    foreach(line ${symbols})
+        # posix format is "<symbol> <type> [<value> <size>]"
+        string(REGEX REPLACE " .*$" "" symbol "${line}")
+        if(symbol MATCHES "${HEAP_SYMBOLS_REGEX}")
+            get_filename_component(object_name ${object} NAME)
+            list(APPEND violations "${object_name}: ${symbol}")
+        elseif(symbol MATCHES "${THROW_PATH_SYMBOLS_REGEX}")
+            get_filename_component(object_name ${object} NAME)
+            list(APPEND exemptions "${object_name}: ${symbol}")
+        endif()
+    endforeach()
+endforeach()
+
+if(exemptions)
+    string(REPLACE ";" "\n  " exemptions "${exemptions}")
+    message(STATUS "Heap allocations allowed on throw paths only:\n  ${exemptions}")
+endif()
+
+if(violations)
+    string(REPLACE ";" "\n  " violations "${violations}")
+    message(FATAL_ERROR "Heap allocations found in the library:\n  ${violations}")
+endif()
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// This file is only compiled for CheckNoHeap.cmake. The library's header-only templates are
+// instantiated here so that their object code is inspected with the rest of the library.
+//
+// PinnacleAcquisition is not instantiated as a whole because `start()` creates a std::thread,
+// which allocates the thread's state once. The acquisition thread's loop only uses the ring and
+// snapshot templates (instantiated below) and PinnacleTouch methods (checked in the library).
+#include "../CirquePinnacle_acquisition.h"
+
+template class PinnacleReportRing<PinnacleTimedReport<RelativeReport>, 64>;
+template class PinnacleReportRing<PinnacleTimedReport<AbsoluteReport>, 64>;
+template class PinnacleReportSnapshot<PinnacleTimedReport<RelativeReport>>;
+template class PinnacleReportSnapshot<PinnacleTimedReport<AbsoluteReport>>;
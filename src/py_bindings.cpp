@@ -201,6 +201,57 @@ PYBIND11_MODULE(cirque_pinnacle, m)
         return ret;
     });
 
+    // ******************** bindings for PinnacleConfigSnapshot
+    py::class_<PinnacleConfigSnapshot> configSnapshot(m, "PinnacleConfigSnapshot");
+    configSnapshot.def(py::init<>());
+    configSnapshot.def_property(
+        "config",
+        [](PinnacleConfigSnapshot& self) {
+            py::list config = py::list(0);
+            for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i) {
+                config.append(py::int_(self.config[i]));
+            }
+            return config;
+        },
+        [](PinnacleConfigSnapshot& self, py::list& config) {
+            for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE && i < py::len(config); ++i) {
+                self.config[i] = py::cast<uint8_t>(config[i]);
+            }
+        });
+    configSnapshot.def_property(
+        "calibration_matrix",
+        [](PinnacleConfigSnapshot& self) {
+            py::list matrix = py::list(0);
+            for (uint8_t i = 0; i < 46; ++i) {
+                matrix.append(py::int_(self.calibrationMatrix[i]));
+            }
+            return matrix;
+        },
+        [](PinnacleConfigSnapshot& self, py::list& matrix) {
+            for (uint8_t i = 0; i < 46 && i < py::len(matrix); ++i) {
+                self.calibrationMatrix[i] = py::cast<int16_t>(matrix[i]);
+            }
+        });
+    configSnapshot.def_readwrite("reload_timer", &PinnacleConfigSnapshot::reloadTimer);
+    configSnapshot.def_readwrite("adc_config", &PinnacleConfigSnapshot::adcConfig);
+    configSnapshot.def_readwrite("x_axis_wide_z_min", &PinnacleConfigSnapshot::xAxisWideZMin);
+    configSnapshot.def_readwrite("y_axis_wide_z_min", &PinnacleConfigSnapshot::yAxisWideZMin);
+    configSnapshot.def_readwrite("finger_stylus", &PinnacleConfigSnapshot::fingerStylus);
+    configSnapshot.def("serialize", [](const PinnacleConfigSnapshot& self) {
+        uint8_t blob[PINNACLE_CONFIG_BLOB_SIZE];
+        self.serialize(blob);
+        return py::bytes(reinterpret_cast<char*>(blob), PINNACLE_CONFIG_BLOB_SIZE);
+    });
+    configSnapshot.def(
+        "deserialize", [](PinnacleConfigSnapshot& self, py::bytes& blob) {
+            std::string buf = blob;
+            if (buf.size() != PINNACLE_CONFIG_BLOB_SIZE) {
+                return false;
+            }
+            return self.deserialize(reinterpret_cast<const uint8_t*>(buf.data()));
+        },
+        py::arg("blob"));
+
     // ******************** bindings for PinnacleTouch
     py::class_<PinnacleTouch, PyPinnacleTouch> pinnacleTouch(m, "PinnacleTouch");
     pinnacleTouch.def(py::init<pinnacle_gpio_t>(), py::arg("dataReadyPin"));
@@ -210,11 +261,18 @@ PYBIND11_MODULE(cirque_pinnacle, m)
     pinnacleTouch.def_property("feed_enabled", &PinnacleTouch::isFeedEnabled, &PinnacleTouch::feedEnabled);
     pinnacleTouch.def("isFeedEnabled", &PinnacleTouch::isFeedEnabled);
     pinnacleTouch.def("feedEnabled", &PinnacleTouch::feedEnabled);
+    pinnacleTouch.def_property("register_cache_enabled", &PinnacleTouch::isRegisterCacheEnabled, &PinnacleTouch::registerCacheEnabled);
+    pinnacleTouch.def("isRegisterCacheEnabled", &PinnacleTouch::isRegisterCacheEnabled);
+    pinnacleTouch.def("registerCacheEnabled", &PinnacleTouch::registerCacheEnabled);
     pinnacleTouch.def_property_readonly("is_hard_configured", &PinnacleTouch::isHardConfigured);
     pinnacleTouch.def("isHardConfigured", &PinnacleTouch::isHardConfigured);
     pinnacleTouch.def_property_readonly("rev2025", &PinnacleTouch::isRev2025);
     pinnacleTouch.def("isRev2025", &PinnacleTouch::isRev2025);
     pinnacleTouch.def("available", &PinnacleTouch::available);
+    pinnacleTouch.def("wait_available", &PinnacleTouch::waitAvailable, py::arg("timeout"),
+                      py::call_guard<py::gil_scoped_release>());
+    pinnacleTouch.def("waitAvailable", &PinnacleTouch::waitAvailable, py::arg("timeout"),
+                      py::call_guard<py::gil_scoped_release>());
     pinnacleTouch.def("absolute_mode_config", &PinnacleTouch::absoluteModeConfig,
                       py::arg("z_idle_count") = 30, py::arg("invert_x") = false, py::arg("invert_x") = false);
     pinnacleTouch.def("absoluteModeConfig", &PinnacleTouch::absoluteModeConfig,
@@ -227,6 +285,34 @@ PYBIND11_MODULE(cirque_pinnacle, m)
                       py::arg("glide_extend") = false, py::arg("intellimouse") = false);
     pinnacleTouch.def("read", static_cast<void (PinnacleTouch::*)(AbsoluteReport*, bool)>(&PinnacleTouch::read), py::arg("report"), py::arg("read_buttons") = true);
     pinnacleTouch.def("read", static_cast<void (PinnacleTouch::*)(RelativeReport*, bool)>(&PinnacleTouch::read), py::arg("report"), py::arg("read_buttons") = true);
+    pinnacleTouch.def(
+        "read_timestamped", [](PinnacleTouch& self, AbsoluteReport* report, bool readButtons) {
+            uint64_t timestamp = 0;
+            self.readTimestamped(report, &timestamp, readButtons);
+            return timestamp;
+        },
+        py::arg("report"), py::arg("read_buttons") = true);
+    pinnacleTouch.def(
+        "read_timestamped", [](PinnacleTouch& self, RelativeReport* report, bool readButtons) {
+            uint64_t timestamp = 0;
+            self.readTimestamped(report, &timestamp, readButtons);
+            return timestamp;
+        },
+        py::arg("report"), py::arg("read_buttons") = true);
+    pinnacleTouch.def(
+        "readTimestamped", [](PinnacleTouch& self, AbsoluteReport* report, bool readButtons) {
+            uint64_t timestamp = 0;
+            self.readTimestamped(report, &timestamp, readButtons);
+            return timestamp;
+        },
+        py::arg("report"), py::arg("read_buttons") = true);
+    pinnacleTouch.def(
+        "readTimestamped", [](PinnacleTouch& self, RelativeReport* report, bool readButtons) {
+            uint64_t timestamp = 0;
+            self.readTimestamped(report, &timestamp, readButtons);
+            return timestamp;
+        },
+        py::arg("report"), py::arg("read_buttons") = true);
     pinnacleTouch.def("clear_status_flags", &PinnacleTouch::clearStatusFlags);
     pinnacleTouch.def("clearStatusFlags", &PinnacleTouch::clearStatusFlags);
     pinnacleTouch.def_property("allow_sleep", &PinnacleTouch::isAllowSleep, &PinnacleTouch::allowSleep);
@@ -250,6 +336,20 @@ PYBIND11_MODULE(cirque_pinnacle, m)
                       py::arg("x_axis_wide_z_min") = 4, py::arg("y_axis_wide_z_min") = 3);
     pinnacleTouch.def("tuneEdgeSensitivity", &PinnacleTouch::tuneEdgeSensitivity,
                       py::arg("x_axis_wide_z_min") = 4, py::arg("y_axis_wide_z_min") = 3);
+    pinnacleTouch.def("get_config_snapshot", [](PinnacleTouch& self) {
+        PinnacleConfigSnapshot snapshot = {};
+        self.getConfigSnapshot(&snapshot);
+        return snapshot;
+    });
+    pinnacleTouch.def("getConfigSnapshot", [](PinnacleTouch& self) {
+        PinnacleConfigSnapshot snapshot = {};
+        self.getConfigSnapshot(&snapshot);
+        return snapshot;
+    });
+    pinnacleTouch.def("set_config_snapshot", &PinnacleTouch::setConfigSnapshot,
+                      py::arg("snapshot"), py::arg("current") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
+    pinnacleTouch.def("setConfigSnapshot", &PinnacleTouch::setConfigSnapshot,
+                      py::arg("snapshot"), py::arg("current") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
     pinnacleTouch.def("set_adc_gain", &PinnacleTouch::setAdcGain, py::arg("sensitivity"));
     pinnacleTouch.def("setAdcGain", &PinnacleTouch::setAdcGain, py::arg("sensitivity"));
 
@@ -274,6 +374,10 @@ PYBIND11_MODULE(cirque_pinnacle, m)
     py::class_<PinnacleTouchSPI> pinnacleTouchSPI(m, "PinnacleTouchSPI", pinnacleTouch);
     pinnacleTouchSPI.def(py::init<pinnacle_gpio_t, pinnacle_gpio_t, uint32_t>(), py::arg("dataReadyPin"), py::arg("slaveSelectPin"), py::arg("spiSpeed") = PINNACLE_SPI_SPEED);
     pinnacleTouchSPI.def("begin", static_cast<bool (PinnacleTouchSPI::*)(void)>(&PinnacleTouchSPI::begin));
+    pinnacleTouchSPI.def("fast_begin", static_cast<bool (PinnacleTouchSPI::*)(const PinnacleConfigSnapshot*)>(&PinnacleTouchSPI::fastBegin),
+                         py::arg("snapshot") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
+    pinnacleTouchSPI.def("fastBegin", static_cast<bool (PinnacleTouchSPI::*)(const PinnacleConfigSnapshot*)>(&PinnacleTouchSPI::fastBegin),
+                         py::arg("snapshot") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
     // The overloaded begin(pinnacle_spi_t*) is not exposed since it would require binding the driver-specific implementation (a lot of work).
     // Additionally, begin(pinnacle_spi_t*) isn't needed on Linux because the SS_PIN param to the c'tor specifies both bus and CEx numbers.
 
@@ -288,12 +392,24 @@ PYBIND11_MODULE(cirque_pinnacle, m)
     twoWire.def("requestFrom", &arduino::TwoWire::requestFrom, py::arg("address"), py::arg("quantity"), py::arg("sendStop") = true);
     twoWire.def("available", &arduino::TwoWire::available);
     twoWire.def("read", &arduino::TwoWire::read);
+    twoWire.def("setProcessShared", &arduino::TwoWire::setProcessShared, py::arg("enable"));
+    twoWire.def("isProcessShared", &arduino::TwoWire::isProcessShared);
+    twoWire.def("lockCount", &arduino::TwoWire::lockCount);
+    twoWire.def("contentionCount", &arduino::TwoWire::contentionCount);
 
     // ******************** bindings for PinnacleTouchI2C
     py::class_<PinnacleTouchI2C> pinnacleTouchI2C(m, "PinnacleTouchI2C", pinnacleTouch);
     pinnacleTouchI2C.def(py::init<pinnacle_gpio_t, uint8_t>(), py::arg("dataReadyPin"), py::arg("slaveAddress") = 0x2A);
     pinnacleTouchI2C.def("begin", static_cast<bool (PinnacleTouchI2C::*)(void)>(&PinnacleTouchI2C::begin));
     pinnacleTouchI2C.def("begin", static_cast<bool (PinnacleTouchI2C::*)(arduino::TwoWire*)>(&PinnacleTouchI2C::begin), py::arg("i2c_bus"));
+    pinnacleTouchI2C.def("fast_begin", static_cast<bool (PinnacleTouchI2C::*)(const PinnacleConfigSnapshot*)>(&PinnacleTouchI2C::fastBegin),
+                         py::arg("snapshot") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
+    pinnacleTouchI2C.def("fastBegin", static_cast<bool (PinnacleTouchI2C::*)(const PinnacleConfigSnapshot*)>(&PinnacleTouchI2C::fastBegin),
+                         py::arg("snapshot") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
+    pinnacleTouchI2C.def("fast_begin", static_cast<bool (PinnacleTouchI2C::*)(arduino::TwoWire*, const PinnacleConfigSnapshot*)>(&PinnacleTouchI2C::fastBegin),
+                         py::arg("i2c_bus"), py::arg("snapshot") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
+    pinnacleTouchI2C.def("fastBegin", static_cast<bool (PinnacleTouchI2C::*)(arduino::TwoWire*, const PinnacleConfigSnapshot*)>(&PinnacleTouchI2C::fastBegin),
+                         py::arg("i2c_bus"), py::arg("snapshot") = static_cast<const PinnacleConfigSnapshot*>(nullptr));
 }
 
 #endif // !defined(ARDUINO)
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <time.h>
+#include "CirquePinnacle.h"
+#include "mock_gpio.h"
+
+namespace mock_gpio {
+
+    static bool level = false;
+    static bool edgePending = false;
+
+    void setLevel(bool value)
+    {
+        if (value && !level) {
+            edgePending = true;
+        }
+        level = value;
+    }
+
+    bool getLevel()
+    {
+        return level;
+    }
+
+} // namespace mock_gpio
+
+namespace cirque_pinnacle_arduino_wrappers {
+
+GPIOClass::GPIOClass()
+{
+}
+
+GPIOClass::~GPIOClass()
+{
+}
+
+void GPIOClass::open(pinnacle_gpio_t, bool)
+{
+}
+
+void GPIOClass::close(pinnacle_gpio_t)
+{
+}
+
+bool GPIOClass::read(pinnacle_gpio_t)
+{
+    return mock_gpio::level;
+}
+
+void GPIOClass::write(pinnacle_gpio_t, bool)
+{
+}
+
+bool GPIOClass::waitForEdge(pinnacle_gpio_t, uint32_t)
+{
+    // nothing else changes the simulated line while waiting, so don't actually wait
+    bool edge = mock_gpio::edgePending;
+    mock_gpio::edgePending = false;
+    return edge;
+}
+
+void GPIOClass::clearEdges(pinnacle_gpio_t)
+{
+    mock_gpio::edgePending = false;
+}
+
+uint64_t GPIOClass::edgeTimestamp(pinnacle_gpio_t)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+int GPIOClass::edgeFd(pinnacle_gpio_t)
+{
+    return -1;
+}
+
+} // namespace cirque_pinnacle_arduino_wrappers
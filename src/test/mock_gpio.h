@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CIRQUEPINNACLE_TEST_MOCK_GPIO_H_
+#define CIRQUEPINNACLE_TEST_MOCK_GPIO_H_
+#include <stdint.h>
+
+// A stand-in for the linux_kernel driver's GPIOClass, so the library can be tested without
+// hardware. Every pin shares 1 simulated line.
+namespace mock_gpio {
+
+    // Set the line's level. A rising edge is queued for GPIOClass::waitForEdge().
+    void setLevel(bool level);
+
+    bool getLevel();
+
+} // namespace mock_gpio
+
+#endif // CIRQUEPINNACLE_TEST_MOCK_GPIO_H_
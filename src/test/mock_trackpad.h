@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CIRQUEPINNACLE_TEST_MOCK_TRACKPAD_H_
+#define CIRQUEPINNACLE_TEST_MOCK_TRACKPAD_H_
+#include <string.h>
+#include "CirquePinnacle.h"
+#include "mock_gpio.h"
+
+// A simulated Pinnacle ASIC behind the RAP interface. Its Data Ready pin is the mock_gpio line.
+class MockTrackpad : public PinnacleTouch
+{
+public:
+    MockTrackpad(bool rev2025 = true) : PinnacleTouch(0), queued(0)
+    {
+        memset(registers, 0, sizeof(registers));
+        registers[pinnacle_registers::FirmwareId::address] = rev2025 ? 0x0E : 0x07;
+        registers[pinnacle_registers::FirmwareId::address + 1] = rev2025 ? 0x75 : 0x3A;
+        mock_gpio::setLevel(false);
+    }
+
+    using PinnacleTouch::begin;
+    using PinnacleTouch::fastBegin;
+
+    // Simulate a new measurement. Measurements that arrive while the DR pin is active are
+    // queued; each clear of the Status register reports the next one.
+    void measure()
+    {
+        if (mock_gpio::getLevel())
+            ++queued;
+        else
+            mock_gpio::setLevel(true);
+    }
+
+    uint8_t registers[256];
+    uint8_t queued; // measurements waiting behind the one being reported
+
+private:
+    void rapWriteCmd(uint8_t*, uint8_t) {}
+
+    void rapWrite(uint8_t address, uint8_t value)
+    {
+        registers[address] = value;
+        if (address == pinnacle_registers::Status::address && !value) {
+            if (queued)
+                --queued; // the DR pin stays active for the next measurement
+            else
+                mock_gpio::setLevel(false);
+        }
+        else if (address == pinnacle_registers::CalConfig::address && (value & 1)) {
+            registers[address] = value & 0xFE; // calibration finishes at once
+            measure();
+        }
+        else if (address == pinnacle_registers::EraControl::address) {
+            registers[address] = 0; // extended register accesses finish at once
+        }
+    }
+
+    void rapWriteBytes(uint8_t address, uint8_t* data, uint8_t count)
+    {
+        for (uint8_t i = 0; i < count; ++i)
+            rapWrite(address + i, data[i]);
+    }
+
+    void rapRead(uint8_t address, uint8_t* data)
+    {
+        *data = registers[address];
+    }
+
+    void rapReadBytes(uint8_t address, uint8_t* data, uint8_t count)
+    {
+        for (uint8_t i = 0; i < count; ++i)
+            data[i] = registers[(uint8_t)(address + i)];
+    }
+};
+
+#endif // CIRQUEPINNACLE_TEST_MOCK_TRACKPAD_H_
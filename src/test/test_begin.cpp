@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mock_trackpad.h"
+#include "test_common.h"
+
+// Measurements pending when the trackpad is (re)configured are discarded
+static void testDrainPending(bool rev2025, bool withSnapshot)
+{
+    PinnacleConfigSnapshot snapshot;
+    {
+        MockTrackpad trackpad(rev2025);
+        CHECK(trackpad.begin());
+        trackpad.getConfigSnapshot(&snapshot);
+    }
+
+    MockTrackpad trackpad(rev2025);
+    trackpad.measure();
+    trackpad.measure();
+    trackpad.measure();
+    CHECK(trackpad.fastBegin(withSnapshot ? &snapshot : nullptr));
+    CHECK(trackpad.queued == 0);
+    CHECK(!trackpad.waitAvailable(0));
+}
+
+int main()
+{
+    testDrainPending(false, true);
+    testDrainPending(false, false);
+    testDrainPending(true, true);
+    testDrainPending(true, false);
+    return TEST_RESULT();
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <cstring>
+#include "CirquePinnacle.h"
+#include "test_common.h"
+
+static void fillSnapshot(PinnacleConfigSnapshot* snapshot)
+{
+    for (uint8_t i = 0; i < PINNACLE_CACHE_SIZE; ++i)
+        snapshot->config[i] = (uint8_t)(0x10 + i);
+    snapshot->reloadTimer = 0x06;
+    snapshot->adcConfig = 0x80;
+    snapshot->xAxisWideZMin = 0x04;
+    snapshot->yAxisWideZMin = 0x03;
+    snapshot->fingerStylus = 0x01;
+    for (uint8_t i = 0; i < 46; ++i)
+        snapshot->calibrationMatrix[i] = (int16_t)(i * 700 - 16000);
+}
+
+static bool sameSnapshot(const PinnacleConfigSnapshot& a, const PinnacleConfigSnapshot& b)
+{
+    return !memcmp(a.config, b.config, PINNACLE_CACHE_SIZE) && a.reloadTimer == b.reloadTimer
+           && a.adcConfig == b.adcConfig && a.xAxisWideZMin == b.xAxisWideZMin
+           && a.yAxisWideZMin == b.yAxisWideZMin && a.fingerStylus == b.fingerStylus
+           && !memcmp(a.calibrationMatrix, b.calibrationMatrix, sizeof(a.calibrationMatrix));
+}
+
+// A serialized snapshot loads back unchanged
+static void testRoundTrip()
+{
+    PinnacleConfigSnapshot original, loaded;
+    fillSnapshot(&original);
+    memset(&loaded, 0, sizeof(loaded));
+    uint8_t blob[PINNACLE_CONFIG_BLOB_SIZE];
+    original.serialize(blob);
+    CHECK(blob[0] == PINNACLE_CONFIG_BLOB_VERSION);
+    CHECK(loaded.deserialize(blob));
+    CHECK(sameSnapshot(original, loaded));
+}
+
+// The calibration matrix is stored big endian, after the version, the registers and the 5 ERA values
+static void testMatrixByteOrder()
+{
+    PinnacleConfigSnapshot snapshot;
+    fillSnapshot(&snapshot);
+    snapshot.calibrationMatrix[0] = 0x1234;
+    snapshot.calibrationMatrix[45] = -2; // 0xFFFE
+    uint8_t blob[PINNACLE_CONFIG_BLOB_SIZE];
+    snapshot.serialize(blob);
+    const uint8_t* matrix = blob + 1 + PINNACLE_CACHE_SIZE + 5;
+    CHECK(matrix[0] == 0x12 && matrix[1] == 0x34);
+    CHECK(matrix[90] == 0xFF && matrix[91] == 0xFE);
+    CHECK(matrix + 92 == blob + PINNACLE_CONFIG_BLOB_SIZE - 1); // only the checksum follows
+}
+
+// A corrupted blob is rejected and the snapshot is left unchanged
+static void testBadChecksum()
+{
+    PinnacleConfigSnapshot original, loaded;
+    fillSnapshot(&original);
+    uint8_t blob[PINNACLE_CONFIG_BLOB_SIZE];
+    original.serialize(blob);
+    blob[20] ^= 0x01;
+    memset(&loaded, 0, sizeof(loaded));
+    PinnacleConfigSnapshot untouched = loaded;
+    CHECK(!loaded.deserialize(blob));
+    CHECK(sameSnapshot(loaded, untouched));
+}
+
+// A blob of another version is rejected, even if its checksum matches
+static void testWrongVersion()
+{
+    PinnacleConfigSnapshot original, loaded;
+    fillSnapshot(&original);
+    uint8_t blob[PINNACLE_CONFIG_BLOB_SIZE];
+    original.serialize(blob);
+    blob[0] = PINNACLE_CONFIG_BLOB_VERSION + 1;
+    blob[PINNACLE_CONFIG_BLOB_SIZE - 1] -= 1; // keep the sum at 0
+    memset(&loaded, 0, sizeof(loaded));
+    PinnacleConfigSnapshot untouched = loaded;
+    CHECK(!loaded.deserialize(blob));
+    CHECK(sameSnapshot(loaded, untouched));
+}
+
+int main()
+{
+    testRoundTrip();
+    testMatrixByteOrder();
+    testBadChecksum();
+    testWrongVersion();
+    return TEST_RESULT();
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mock_trackpad.h"
+#include "test_common.h"
+
+class EraTrackpad : public MockTrackpad
+{
+public:
+    EraTrackpad() : MockTrackpad(false) {}
+
+    // poll the queue as if a blocking extended register access was in progress
+    PinnacleEraStatus pollDuringBlockingAccess()
+    {
+        EraSession session(this);
+        uint8_t before[256];
+        memcpy(before, registers, sizeof(registers));
+        PinnacleEraStatus status = eraPoll();
+        untouched = !memcmp(before, registers, sizeof(registers));
+        return status;
+    }
+
+    bool untouched = false;
+};
+
+// The queue waits while a blocking extended register access is in progress
+static void testWaitForBlockingAccess()
+{
+    EraTrackpad trackpad;
+    CHECK(trackpad.begin());
+    CHECK(trackpad.isFeedEnabled());
+    CHECK(trackpad.eraQueueWrite(0x0187, 0x55));
+
+    // before the queue holds the feed
+    CHECK(trackpad.pollDuringBlockingAccess() == PINNACLE_ERA_BUSY);
+    CHECK(trackpad.untouched);
+    CHECK(trackpad.eraPending() == 1);
+
+    // while the queue holds the feed
+    CHECK(trackpad.eraQueueWrite(0x0188, 0x66));
+    CHECK(trackpad.eraPoll() == PINNACLE_ERA_BUSY); // starts the first operation
+    CHECK(trackpad.pollDuringBlockingAccess() == PINNACLE_ERA_BUSY);
+    CHECK(trackpad.untouched);
+    CHECK(trackpad.eraPending() == 2);
+
+    PinnacleEraStatus status = PINNACLE_ERA_BUSY;
+    for (uint8_t i = 0; i < 8 && status == PINNACLE_ERA_BUSY; ++i)
+        status = trackpad.eraPoll();
+    CHECK(status == PINNACLE_ERA_COMPLETE);
+    CHECK(trackpad.eraPending() == 0);
+    CHECK(trackpad.isFeedEnabled()); // restored
+}
+
+int main()
+{
+    testWaitForBlockingAccess();
+    return TEST_RESULT();
+}
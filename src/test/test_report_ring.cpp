@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <thread>
+#include "CirquePinnacle_acquisition.h"
+#include "test_common.h"
+
+// An item spanning several words, so a torn copy can be detected
+struct Item
+{
+    uint32_t index;
+    uint32_t check[4];
+};
+
+static Item makeItem(uint32_t index)
+{
+    Item item;
+    item.index = index;
+    for (uint32_t i = 0; i < 4; ++i)
+        item.check[i] = index * (i + 3) + 1;
+    return item;
+}
+
+static bool isIntact(const Item& item)
+{
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (item.check[i] != item.index * (i + 3) + 1)
+            return false;
+    }
+    return true;
+}
+
+typedef PinnacleReportRing<Item, 8> Ring;
+
+struct PinnacleAcquisitionTest
+{
+    static void startIndicesAt(Ring* ring, uint32_t index)
+    {
+        ring->_head.store(index);
+        ring->_tail.store(index);
+    }
+};
+
+// Items are popped in the order they were pushed; an empty ring has nothing to pop
+static void testFifoOrder()
+{
+    Ring ring;
+    Item item;
+    CHECK(ring.size() == 0);
+    CHECK(!ring.pop(&item));
+    for (uint32_t i = 0; i < 5; ++i)
+        CHECK(ring.push(makeItem(i)));
+    CHECK(ring.size() == 5);
+    for (uint32_t i = 0; i < 5; ++i) {
+        CHECK(ring.pop(&item));
+        CHECK(item.index == i && isIntact(item));
+    }
+    CHECK(ring.size() == 0);
+    CHECK(!ring.pop(&item));
+    CHECK(ring.dropped() == 0);
+}
+
+// A full ring discards its oldest items in the overwrite mode
+static void testOverwrite()
+{
+    Ring ring(PINNACLE_OVERFLOW_OVERWRITE);
+    for (uint32_t i = 0; i < 8; ++i)
+        CHECK(ring.push(makeItem(i)));
+    CHECK(ring.size() == 8);
+    CHECK(!ring.push(makeItem(8)));
+    CHECK(!ring.push(makeItem(9)));
+    CHECK(ring.size() == 8);
+    CHECK(ring.dropped() == 2);
+    Item item;
+    for (uint32_t i = 2; i < 10; ++i) {
+        CHECK(ring.pop(&item));
+        CHECK(item.index == i);
+    }
+    CHECK(!ring.pop(&item));
+}
+
+// A full ring discards the new items in the drop mode
+static void testDrop()
+{
+    Ring ring(PINNACLE_OVERFLOW_DROP);
+    CHECK(ring.getOverflowMode() == PINNACLE_OVERFLOW_DROP);
+    for (uint32_t i = 0; i < 8; ++i)
+        CHECK(ring.push(makeItem(i)));
+    CHECK(!ring.push(makeItem(8)));
+    CHECK(ring.size() == 8);
+    CHECK(ring.dropped() == 1);
+    Item item;
+    CHECK(ring.pop(&item));
+    CHECK(item.index == 0);
+    CHECK(ring.push(makeItem(9))); // there is room again
+    for (uint32_t i = 1; i < 8; ++i) {
+        CHECK(ring.pop(&item));
+        CHECK(item.index == i);
+    }
+    CHECK(ring.pop(&item));
+    CHECK(item.index == 9);
+    CHECK(!ring.pop(&item));
+}
+
+// The indices wrap at 2^32 without losing or reordering items
+static void testIndexWrap()
+{
+    Ring ring;
+    PinnacleAcquisitionTest::startIndicesAt(&ring, 0xFFFFFFFC);
+    Item item;
+    for (uint32_t i = 0; i < 10; ++i)
+        ring.push(makeItem(i)); // overwrites 0 and 1
+    CHECK(ring.size() == 8);
+    CHECK(ring.dropped() == 2);
+    for (uint32_t i = 2; i < 10; ++i) {
+        CHECK(ring.pop(&item));
+        CHECK(item.index == i);
+    }
+    CHECK(ring.size() == 0);
+    CHECK(!ring.pop(&item));
+}
+
+// A producer and a consumer thread never see torn, repeated or reordered items
+static void testStress(PinnacleOverflowMode mode)
+{
+    const uint32_t count = 1000000;
+    Ring ring(mode);
+    std::atomic<bool> done(false);
+    uint32_t accepted = 0;
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < count; ++i)
+            accepted += ring.push(makeItem(i));
+        done.store(true);
+    });
+
+    uint32_t received = 0, torn = 0, outOfOrder = 0;
+    int64_t last = -1;
+    Item item;
+    while (true) {
+        bool finished = done.load();
+        while (ring.pop(&item)) {
+            ++received;
+            torn += !isIntact(item);
+            outOfOrder += (int64_t)item.index <= last;
+            last = item.index;
+        }
+        if (finished)
+            break;
+    }
+    producer.join();
+
+    CHECK(torn == 0);
+    CHECK(outOfOrder == 0);
+    // every item is either received or counted as dropped
+    CHECK(received + ring.dropped() == count);
+    if (mode == PINNACLE_OVERFLOW_OVERWRITE)
+        CHECK(last == count - 1); // the newest item is never discarded
+    else
+        CHECK(received == accepted);
+}
+
+int main()
+{
+    testFifoOrder();
+    testOverwrite();
+    testDrop();
+    testIndexWrap();
+    testStress(PINNACLE_OVERFLOW_OVERWRITE);
+    testStress(PINNACLE_OVERFLOW_DROP);
+    return TEST_RESULT();
+}
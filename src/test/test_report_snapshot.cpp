@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <thread>
+#include "CirquePinnacle_acquisition.h"
+#include "test_common.h"
+
+// A value spanning several words, so a torn copy can be detected
+struct Value
+{
+    uint32_t index;
+    uint32_t check[4];
+};
+
+static Value makeValue(uint32_t index)
+{
+    Value value;
+    value.index = index;
+    for (uint32_t i = 0; i < 4; ++i)
+        value.check[i] = index * (i + 3) + 1;
+    return value;
+}
+
+static bool isIntact(const Value& value)
+{
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (value.check[i] != value.index * (i + 3) + 1)
+            return false;
+    }
+    return true;
+}
+
+typedef PinnacleReportSnapshot<Value> Snapshot;
+
+struct PinnacleAcquisitionTest
+{
+    static void startSequenceAt(Snapshot* snapshot, uint32_t sequence)
+    {
+        snapshot->_sequence.store(sequence);
+        snapshot->_started.store(sequence);
+    }
+};
+
+// Nothing can be loaded before the first value is published; then the latest value is loaded
+static void testLatestValue()
+{
+    Snapshot snapshot;
+    Value value;
+    uint32_t sequence = 42;
+    CHECK(snapshot.sequence() == 0);
+    CHECK(!snapshot.load(&value, &sequence));
+    CHECK(sequence == 42); // not changed
+
+    snapshot.publish(makeValue(1));
+    CHECK(snapshot.load(&value, &sequence));
+    CHECK(value.index == 1 && isIntact(value));
+    CHECK(sequence == 1);
+
+    snapshot.publish(makeValue(2));
+    snapshot.publish(makeValue(3));
+    CHECK(snapshot.load(&value)); // the sequence number is optional
+    CHECK(value.index == 3);
+    CHECK(snapshot.load(&value, &sequence));
+    CHECK(value.index == 3 && sequence == 3);
+    CHECK(snapshot.sequence() == 3);
+}
+
+// The sequence number skips 0 when it wraps, so a value stays loadable
+static void testSequenceWrap()
+{
+    Snapshot snapshot;
+    snapshot.publish(makeValue(0));
+    PinnacleAcquisitionTest::startSequenceAt(&snapshot, 0xFFFFFFFE);
+    Value value;
+    uint32_t sequence = 0;
+    for (uint32_t i = 1; i < 5; ++i) {
+        snapshot.publish(makeValue(i));
+        CHECK(snapshot.sequence() != 0);
+        CHECK(snapshot.load(&value, &sequence));
+        CHECK(value.index == i && isIntact(value));
+        CHECK(sequence == snapshot.sequence());
+    }
+    CHECK(sequence == 4); // 0xFFFFFFFF -> 2 -> 3 -> 4
+}
+
+// A reader racing the writer never sees a torn value or a value older than one it already saw
+static void testStress()
+{
+    const uint32_t count = 1000000;
+    Snapshot snapshot;
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= count; ++i)
+            snapshot.publish(makeValue(i));
+        done.store(true);
+    });
+
+    uint32_t torn = 0, older = 0, mismatched = 0, last = 0, sequence;
+    Value value;
+    while (true) {
+        bool finished = done.load();
+        if (snapshot.load(&value, &sequence)) {
+            torn += !isIntact(value);
+            older += value.index < last;
+            mismatched += value.index != sequence; // no wrap in this test
+            last = value.index;
+        }
+        if (finished)
+            break;
+    }
+    writer.join();
+
+    CHECK(torn == 0);
+    CHECK(older == 0);
+    CHECK(mismatched == 0);
+    CHECK(last == count);
+}
+
+int main()
+{
+    testLatestValue();
+    testSequenceWrap();
+    testStress();
+    return TEST_RESULT();
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mock_trackpad.h"
+#include "test_common.h"
+
+// Data that arrives right after the Status register is cleared must not be missed
+static void testDataAfterClear()
+{
+    MockTrackpad trackpad;
+    CHECK(trackpad.begin());
+    CHECK(!trackpad.waitAvailable(0));
+
+    trackpad.measure();
+    CHECK(trackpad.waitAvailable(0));
+    trackpad.clearStatusFlags();
+    trackpad.measure(); // within 50 us of the clear (its edge is discarded by waitAvailable())
+    CHECK(trackpad.waitAvailable(0));
+    trackpad.clearStatusFlags();
+    CHECK(!trackpad.waitAvailable(0));
+}
+
+// Measurements queued behind a cleared one keep the DR pin active
+static void testQueuedData()
+{
+    MockTrackpad trackpad;
+    CHECK(trackpad.begin());
+    trackpad.measure();
+    trackpad.measure();
+    trackpad.clearStatusFlags();
+    CHECK(trackpad.waitAvailable(0));
+    trackpad.clearStatusFlags();
+    CHECK(!trackpad.waitAvailable(0));
+}
+
+int main()
+{
+    testDataAfterClear();
+    testQueuedData();
+    return TEST_RESULT();
+}
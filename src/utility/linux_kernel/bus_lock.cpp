@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef ARDUINO
+    #include <sys/file.h> // flock()
+    #include <errno.h>    // errno
+    #include <stdio.h>    // snprintf()
+    #include <string.h>   // strerror()
+    #include <stdexcept>  // std::runtime_error
+    #include "bus_lock.h"
+
+    #ifdef __cplusplus
+extern "C" {
+    #endif
+
+namespace cirque_pinnacle_arduino_wrappers {
+
+    BusLock::BusLock()
+        : lockFd(-1), depth(0), processShared(false), locks(0), contentions(0)
+    {
+    }
+
+    void BusLock::lock()
+    {
+        if (!mutex.try_lock()) {
+            contentions.fetch_add(1, std::memory_order_relaxed);
+            mutex.lock();
+        }
+        if (depth++) {
+            return; // nested lock by the same thread
+        }
+        locks.fetch_add(1, std::memory_order_relaxed);
+        if (!processShared || lockFd < 0) {
+            return;
+        }
+        int ret = flock(lockFd, LOCK_EX | LOCK_NB);
+        if (ret == -1 && errno == EWOULDBLOCK) {
+            contentions.fetch_add(1, std::memory_order_relaxed);
+            do {
+                ret = flock(lockFd, LOCK_EX);
+            } while (ret == -1 && errno == EINTR);
+        }
+        if (ret == -1) {
+            int error = errno;
+            depth = 0;
+            mutex.unlock();
+            char msg[96];
+            snprintf(msg, sizeof(msg), "[BusLock::lock] Could not lock bus device; %s", strerror(error));
+            throw std::runtime_error(msg);
+        }
+    }
+
+    void BusLock::unlock()
+    {
+        if (--depth == 0 && processShared && lockFd >= 0) {
+            flock(lockFd, LOCK_UN);
+        }
+        mutex.unlock();
+    }
+
+    void BusLock::setProcessShared(bool enable)
+    {
+        processShared = enable;
+    }
+
+    bool BusLock::isProcessShared() const
+    {
+        return processShared;
+    }
+
+    uint32_t BusLock::lockCount() const
+    {
+        return locks.load(std::memory_order_relaxed);
+    }
+
+    uint32_t BusLock::contentionCount() const
+    {
+        return contentions.load(std::memory_order_relaxed);
+    }
+
+} // namespace cirque_pinnacle_arduino_wrappers
+
+    #ifdef __cplusplus
+}
+    #endif
+
+#endif // !defined(ARDUINO)
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2023 Brendan Doherty (2bndy5)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef CIRQUEPINNACLE_UTILITY_LINUX_KERNEL_BUS_LOCK_H_
+#define CIRQUEPINNACLE_UTILITY_LINUX_KERNEL_BUS_LOCK_H_
+#ifndef ARDUINO
+
+    #include <cstdint> // uintXX_t
+    #include <atomic>
+    #include <mutex>
+
+    #ifdef __cplusplus
+extern "C" {
+    #endif
+
+namespace cirque_pinnacle_arduino_wrappers {
+
+    // This driver's bus objects implement BusLock::lock() and BusLock::unlock()
+    #define PINNACLE_BUS_LOCK 1
+
+    /**
+     * Arbitrates access to a bus object (SPIClass or TwoWire) that is shared by multiple threads
+     * or processes. This satisfies the C++ Lockable requirements, so it can be used with
+     * ``std::lock_guard``.
+     *
+     * The lock is recursive: the thread that holds it can lock it again (eg. a register access
+     * that is part of a multi-transfer ERA sequence).
+     */
+    class BusLock
+    {
+    public:
+        BusLock();
+
+        /**
+         * Wait for (and take) exclusive access to the bus.
+         * If the bus is shared with other processes, then the bus' device file is also locked
+         * with flock() when the outermost lock is taken.
+         */
+        void lock();
+
+        /** Release the lock taken with `lock()`. */
+        void unlock();
+
+        /**
+         * Enable or disable locking the bus' device file when the bus is locked. Enable this if
+         * other processes (that also use flock()) access the same bus.
+         * @note Only change this while the bus is not locked.
+         */
+        void setProcessShared(bool enable);
+
+        /** @returns true if the bus' device file is locked when the bus is locked. */
+        bool isProcessShared() const;
+
+        /** @returns The number of times the bus was locked (not counting nested locks). */
+        uint32_t lockCount() const;
+
+        /**
+         * @returns The number of times a lock had to wait because the bus was held by another
+         * thread or process.
+         */
+        uint32_t contentionCount() const;
+
+    protected:
+        /** The bus' device file (set by the derived bus class); -1 if not opened. */
+        int lockFd;
+
+    private:
+        std::recursive_mutex mutex;
+        uint32_t depth; // only changed by the thread holding `mutex`
+        bool processShared;
+        std::atomic<uint32_t> locks;
+        std::atomic<uint32_t> contentions;
+    };
+
+} // namespace cirque_pinnacle_arduino_wrappers
+
+    #ifdef __cplusplus
+}
+    #endif
+
+#endif // !defined(ARDUINO)
+#endif // CIRQUEPINNACLE_UTILITY_LINUX_KERNEL_BUS_LOCK_H_
@@ -20,67 +20,135 @@
     #include <unistd.h>    // close()
     #include <fcntl.h>     // open()
     #include <sys/ioctl.h> // ioctl()
+    #include <poll.h>      // poll()
+    #include <time.h>      // clock_gettime()
     #include <errno.h>     // errno
+    #include <stdio.h>     // snprintf()
     #include <string.h>    // strerror(), memset(), strcpy()
-    #include <map>
+    #include <atomic>
+    #include <mutex>
     #include "linux/gpio.h"
     #include "gpio.h"
 
 namespace cirque_pinnacle_arduino_wrappers {
 
-// instantiate some global structs to setup cache
-// doing this globally ensures the data struct is zero-ed out
-typedef int gpio_fd; // for readability
-std::map<pinnacle_gpio_t, gpio_fd> cachedPins;
-struct gpio_v2_line_request request;
-struct gpio_v2_line_values data;
+// A directly indexed table of cached pins' line requests.
+// Only open() and close() modify the table (while holding `tableLock`). All other functions only
+// load a pin's file descriptor, so they can be called from multiple threads without locking.
+struct GPIOPin
+{
+    std::atomic<int> fd;
+    // timestamp (ns) of the latest rising edge not yet fetched by edgeTimestamp().
+    // Atomic because a manager thread may wait for edges while another thread reads the pin
+    // (on 32-bit ARM CPUs without lock-free 64-bit atomics, this uses a lock).
+    std::atomic<uint64_t> lastEdge;
+};
 
-// initialize static member.
-int GPIOChipCache::fd = -1;
+// Info about a GPIO chip is only fetched once
+struct GPIOChip
+{
+    bool infoCached;
+    uint32_t lines;
+};
 
-void GPIOChipCache::openDevice()
+struct GPIOTable
 {
-    if (fd < 0) {
-        fd = open(PINNACLE_LINUX_GPIO_CHIP, O_RDONLY);
-        if (fd < 0) {
-            std::string msg = "Can't open device ";
-            msg += PINNACLE_LINUX_GPIO_CHIP;
-            msg += "; ";
-            msg += strerror(errno);
-            throw GPIOException(msg);
-            return;
+    GPIOPin pins[PINNACLE_GPIO_MAX_CHIPS][PINNACLE_GPIO_MAX_LINES];
+    GPIOChip chips[PINNACLE_GPIO_MAX_CHIPS];
+    std::mutex tableLock;
+
+    GPIOTable()
+    {
+        for (unsigned int chip = 0; chip < PINNACLE_GPIO_MAX_CHIPS; ++chip) {
+            chips[chip].infoCached = false;
+            chips[chip].lines = 0;
+            for (unsigned int line = 0; line < PINNACLE_GPIO_MAX_LINES; ++line) {
+                pins[chip][line].fd = -1;
+                pins[chip][line].lastEdge.store(0, std::memory_order_relaxed);
+            }
         }
     }
+
+    /// Should be called automatically on program exit.
+    /// What we need here is to make sure that the File Descriptors used to
+    /// control GPIO pins are properly closed.
+    ~GPIOTable()
+    {
+        for (unsigned int chip = 0; chip < PINNACLE_GPIO_MAX_CHIPS; ++chip) {
+            for (unsigned int line = 0; line < PINNACLE_GPIO_MAX_LINES; ++line) {
+                int fd = pins[chip][line].fd.exchange(-1);
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        }
+    }
+};
+
+// GPIO pin cache manager
+GPIOTable gpioTable;
+
+[[noreturn]] static void throwGPIOException(const char* prefix, pinnacle_gpio_t port, const char* reason)
+{
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s (pin %u:%u); %s", prefix, port >> 16, port & 0xFFFF, reason);
+    throw GPIOException(msg);
 }
 
-void GPIOChipCache::closeDevice()
+// the number N if `path` is "/dev/gpiochipN"; otherwise -1
+static constexpr int chipNumber(const char* path)
 {
-    if (fd >= 0) {
-        close(fd);
-        fd = -1;
+    const char prefix[] = "/dev/gpiochip";
+    for (unsigned int i = 0; i < sizeof(prefix) - 1; ++i) {
+        if (path[i] != prefix[i]) {
+            return -1;
+        }
+    }
+    path += sizeof(prefix) - 1;
+    if (!*path) {
+        return -1;
+    }
+    int number = 0;
+    for (; *path; ++path) {
+        if (*path < '0' || *path > '9') {
+            return -1;
+        }
+        number = number * 10 + (*path - '0');
+    }
+    return number;
+}
+
+// chip 0 is an alias of PINNACLE_LINUX_GPIO_CHIP; this is that chip's own number (if known)
+static constexpr int defaultChip = chipNumber(PINNACLE_LINUX_GPIO_CHIP);
+
+static unsigned int getChip(pinnacle_gpio_t port)
+{
+    unsigned int chip = port >> 16;
+    // use the same table entry for both ways of naming a line on the default chip
+    if (defaultChip > 0 && chip == (unsigned int)defaultChip) {
+        chip = 0;
+    }
+    if (chip >= PINNACLE_GPIO_MAX_CHIPS || (port & 0xFFFF) >= PINNACLE_GPIO_MAX_LINES) {
+        throwGPIOException("[GPIO] pin number out of range", port, "see PINNACLE_GPIO_MAX_CHIPS and PINNACLE_GPIO_MAX_LINES");
     }
+    return chip;
 }
 
-GPIOChipCache::GPIOChipCache()
+static GPIOPin& getPin(pinnacle_gpio_t port)
 {
-    request.num_lines = 1;
-    strcpy(request.consumer, "CirquePinnacle lib");
-    data.mask = 1ULL; // only change value for specified pin
+    return gpioTable.pins[getChip(port)][port & 0xFFFF];
 }
 
-GPIOChipCache::~GPIOChipCache()
+// get an opened pin's file descriptor
+static int getPinFd(pinnacle_gpio_t port, const char* caller)
 {
-    closeDevice();
-    for (std::map<pinnacle_gpio_t, gpio_fd>::iterator i = cachedPins.begin(); i != cachedPins.end(); ++i) {
-        if (i->second > 0) {
-            close(i->second);
-        }
+    int fd = getPin(port).fd.load(std::memory_order_acquire);
+    if (fd < 0) {
+        throwGPIOException(caller, port, "pin not initialized! Use GPIO::open() first");
     }
+    return fd;
 }
 
-// GPIO chip cache manager
-GPIOChipCache gpioCache;
-
 GPIOClass::GPIOClass()
 {
 }
@@ -91,108 +159,153 @@ GPIOClass::~GPIOClass()
 
 void GPIOClass::open(pinnacle_gpio_t port, bool direction)
 {
-    gpioCache.openDevice();
+    unsigned int chip = getChip(port);
+    uint32_t line = port & 0xFFFF;
+    GPIOPin& pin = gpioTable.pins[chip][line];
 
-    // get chip info
-    gpiochip_info info;
-    memset(&info, 0, sizeof(info));
-    int ret = ioctl(gpioCache.fd, GPIO_GET_CHIPINFO_IOCTL, &info);
-    if (ret < 0) {
-        std::string msg = "Could not gather info about ";
-        msg += PINNACLE_LINUX_GPIO_CHIP;
-        throw GPIOException(msg);
-        return;
-    }
+    struct gpio_v2_line_config config;
+    memset(&config, 0, sizeof(config));
+    config.flags = direction ? GPIO_V2_LINE_FLAG_OUTPUT : (GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING);
 
-    if (port > info.lines) {
-        std::string msg = "pin number " + std::to_string(port) + " not available for " + PINNACLE_LINUX_GPIO_CHIP;
-        throw GPIOException(msg);
+    std::lock_guard<std::mutex> guard(gpioTable.tableLock);
+
+    int fd = pin.fd.load(std::memory_order_relaxed);
+    if (fd >= 0) { // pin already in use; just re-configure the direction
+        if (ioctl(fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) == -1) {
+            throwGPIOException("[GPIO::open] Can't set line config", port, strerror(errno));
+        }
         return;
     }
 
-    // check if pin is already in use
-    std::map<pinnacle_gpio_t, gpio_fd>::iterator pin = cachedPins.find(port);
-    if (pin == cachedPins.end()) { // pin not in use; add it to cached request
-        request.offsets[0] = port;
-        request.fd = 0;
+    char device[32];
+    if (chip == 0) {
+        snprintf(device, sizeof(device), "%s", PINNACLE_LINUX_GPIO_CHIP);
     }
     else {
-        request.fd = pin->second;
+        snprintf(device, sizeof(device), "/dev/gpiochip%u", chip);
+    }
+    int chipFd = ::open(device, O_RDONLY);
+    if (chipFd < 0) {
+        throwGPIOException("[GPIO::open] Can't open GPIO chip", port, strerror(errno));
     }
 
-    if (request.fd <= 0) {
-        ret = ioctl(gpioCache.fd, GPIO_V2_GET_LINE_IOCTL, &request);
-        if (ret == -1 || request.fd <= 0) {
-            std::string msg = "[GPIO::open] Can't get line handle from IOCTL; ";
-            msg += strerror(errno);
-            throw GPIOException(msg);
-            return;
+    GPIOChip& chipInfo = gpioTable.chips[chip];
+    if (!chipInfo.infoCached) {
+        gpiochip_info info;
+        memset(&info, 0, sizeof(info));
+        if (ioctl(chipFd, GPIO_GET_CHIPINFO_IOCTL, &info) < 0) {
+            int error = errno;
+            ::close(chipFd);
+            throwGPIOException("[GPIO::open] Could not gather info about GPIO chip", port, strerror(error));
         }
+        chipInfo.lines = info.lines;
+        chipInfo.infoCached = true;
+    }
+    if (line >= chipInfo.lines) {
+        ::close(chipFd);
+        throwGPIOException("[GPIO::open] pin number not available", port, device);
     }
-    gpioCache.closeDevice(); // in case other apps want to access it
-
-    // set the pin and direction
-    request.config.flags = direction ? GPIO_V2_LINE_FLAG_OUTPUT : GPIO_V2_LINE_FLAG_INPUT;
 
-    ret = ioctl(request.fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &request.config);
-    if (ret == -1) {
-        std::string msg = "[gpio::open] Can't set line config; ";
-        msg += strerror(errno);
-        throw GPIOException(msg);
-        return;
+    struct gpio_v2_line_request request;
+    memset(&request, 0, sizeof(request));
+    request.num_lines = 1;
+    request.offsets[0] = line;
+    request.config = config;
+    strcpy(request.consumer, "CirquePinnacle lib");
+    int ret = ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request);
+    int error = errno;
+    ::close(chipFd); // in case other apps want to access it
+    if (ret == -1 || request.fd <= 0) {
+        throwGPIOException("[GPIO::open] Can't get line handle from IOCTL", port, strerror(error));
     }
-    cachedPins.insert(std::pair<pinnacle_gpio_t, gpio_fd>(port, request.fd));
+    pin.lastEdge.store(0, std::memory_order_relaxed);
+    pin.fd.store(request.fd, std::memory_order_release);
 }
 
 void GPIOClass::close(pinnacle_gpio_t port)
 {
-    std::map<pinnacle_gpio_t, gpio_fd>::iterator pin = cachedPins.find(port);
-    if (pin == cachedPins.end()) {
-        return;
-    }
-    if (pin->second > 0) {
-        ::close(pin->second);
+    GPIOPin& pin = getPin(port);
+    std::lock_guard<std::mutex> guard(gpioTable.tableLock);
+    int fd = pin.fd.exchange(-1);
+    if (fd >= 0) {
+        ::close(fd);
     }
-    cachedPins.erase(pin);
 }
 
 bool GPIOClass::read(pinnacle_gpio_t port)
 {
-    std::map<pinnacle_gpio_t, gpio_fd>::iterator pin = cachedPins.find(port);
-    if (pin == cachedPins.end() || pin->second <= 0) {
-        throw GPIOException("[GPIO::read] pin not initialized! Use GPIO::open() first");
-        return -1;
-    }
+    int fd = getPinFd(port, "[GPIO::read]");
 
+    struct gpio_v2_line_values data;
+    data.mask = 1ULL; // only get value for specified pin
     data.bits = 0ULL;
 
-    int ret = ioctl(pin->second, GPIO_V2_LINE_GET_VALUES_IOCTL, &data);
-    if (ret == -1) {
-        std::string msg = "[GPIO::read] Can't get line value from IOCTL; ";
-        msg += strerror(errno);
-        throw GPIOException(msg);
-        return ret;
+    if (ioctl(fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &data) == -1) {
+        throwGPIOException("[GPIO::read] Can't get line value from IOCTL", port, strerror(errno));
     }
     return data.bits & 1ULL;
 }
 
 void GPIOClass::write(pinnacle_gpio_t port, bool value)
 {
-    std::map<pinnacle_gpio_t, gpio_fd>::iterator pin = cachedPins.find(port);
-    if (pin == cachedPins.end() || pin->second <= 0) {
-        throw GPIOException("[GPIO::write] pin not initialized! Use GPIO::open() first");
-        return;
-    }
+    int fd = getPinFd(port, "[GPIO::write]");
 
+    struct gpio_v2_line_values data;
+    data.mask = 1ULL; // only change value for specified pin
     data.bits = (unsigned long long)value;
 
-    int ret = ioctl(pin->second, GPIO_V2_LINE_SET_VALUES_IOCTL, &data);
+    if (ioctl(fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &data) == -1) {
+        throwGPIOException("[GPIO::write] Can't set line value from IOCTL", port, strerror(errno));
+    }
+}
+
+bool GPIOClass::waitForEdge(pinnacle_gpio_t port, uint32_t timeout)
+{
+    int fd = getPinFd(port, "[GPIO::waitForEdge]");
+
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ret = poll(&pfd, 1, (int)timeout);
     if (ret == -1) {
-        std::string msg = "[GPIO::write] Can't set line value from IOCTL; ";
-        msg += strerror(errno);
-        throw GPIOException(msg);
-        return;
+        throwGPIOException("[GPIO::waitForEdge] Can't poll line for events", port, strerror(errno));
     }
+    if (ret == 0) {
+        return false; // timeout expired
+    }
+
+    struct gpio_v2_line_event event;
+    if (::read(fd, &event, sizeof(event)) != sizeof(event)) {
+        throwGPIOException("[GPIO::waitForEdge] Can't read line event", port, strerror(errno));
+    }
+    getPin(port).lastEdge.store(event.timestamp_ns, std::memory_order_relaxed);
+    return true;
+}
+
+void GPIOClass::clearEdges(pinnacle_gpio_t port)
+{
+    while (waitForEdge(port, 0)) {
+    }
+}
+
+uint64_t GPIOClass::edgeTimestamp(pinnacle_gpio_t port)
+{
+    clearEdges(port); // fetch the latest edge's timestamp
+    GPIOPin& pin = getPin(port);
+    uint64_t timestamp = pin.lastEdge.exchange(0, std::memory_order_relaxed);
+    if (!timestamp) {
+        // no edge detected; fall back to the same clock that the kernel uses for edge events
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        timestamp = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    }
+    return timestamp;
+}
+
+int GPIOClass::edgeFd(pinnacle_gpio_t port)
+{
+    return getPinFd(port, "[GPIO::edgeFd]");
 }
 
 } // namespace cirque_pinnacle_arduino_wrappers
@@ -22,7 +22,7 @@
 
     #include <cstdint>      // uintXX_t
     #include <stdexcept>    // std::exception, std::string
-    #include "linux/gpio.h" // gpiochip_info
+    #include "linux/gpio.h" // gpio_v2_line_event
 
     #ifdef __cplusplus
 extern "C" {
@@ -36,6 +36,34 @@ typedef unsigned int pinnacle_gpio_t;
          */
         #define PINNACLE_LINUX_GPIO_CHIP "/dev/gpiochip0"
     #endif
+
+    #ifndef PINNACLE_GPIO_MAX_CHIPS
+        /**
+         * The number of GPIO chips that can be used. Chip 0 is `PINNACLE_LINUX_GPIO_CHIP`; any
+         * other chip number ``N`` is `/dev/gpiochipN`. If `PINNACLE_LINUX_GPIO_CHIP` is
+         * `/dev/gpiochipN`, then chip ``N`` is the same as chip 0.
+         */
+        #define PINNACLE_GPIO_MAX_CHIPS 4
+    #endif
+
+    #ifndef PINNACLE_GPIO_MAX_LINES
+        /**
+         * The number of lines (per GPIO chip) that can be used.
+         */
+        #define PINNACLE_GPIO_MAX_LINES 128
+    #endif
+
+    /**
+     * Use this to specify a pin on a GPIO chip other than `PINNACLE_LINUX_GPIO_CHIP`.
+     * Pin numbers that don't use this macro refer to lines on `PINNACLE_LINUX_GPIO_CHIP`.
+     * @param chip The GPIO chip number (eg. ``1`` for `/dev/gpiochip1`).
+     * @param line The line offset on the GPIO chip.
+     */
+    #define PINNACLE_GPIO(chip, line) ((pinnacle_gpio_t)(((chip) << 16) | (line)))
+
+    // This driver implements GPIOClass::waitForEdge(), GPIOClass::clearEdges(),
+    // GPIOClass::edgeTimestamp(), and GPIOClass::edgeFd()
+    #define PINNACLE_GPIO_EDGE_EVENTS 1
 namespace cirque_pinnacle_arduino_wrappers {
 
     /** Specific exception for GPIO errors */
@@ -48,28 +76,6 @@ namespace cirque_pinnacle_arduino_wrappers {
         }
     };
 
-    /// A struct to manage the GPIO chip file descriptor.
-    /// This struct's destructor should close any cached GPIO pin requests' file descriptors.
-    struct GPIOChipCache
-    {
-        static int fd;
-
-        /// Open the File Descriptor for the GPIO chip
-        void openDevice();
-
-        /// Close the File Descriptor for the GPIO chip
-        void closeDevice();
-
-        /// should be called automatically on program start.
-        /// Here, we do some one-off configuration.
-        GPIOChipCache();
-
-        /// Should be called automatically on program exit.
-        /// What we need here is to make sure that the File Descriptors used to
-        /// control GPIO pins are properly closed.
-        ~GPIOChipCache();
-    };
-
     class GPIOClass
     {
 
@@ -85,7 +91,10 @@ namespace cirque_pinnacle_arduino_wrappers {
         /**
          * Similar to Arduino pinMode(pin, mode);
          * @param port
-         * @param direction
+         * @param direction Input pins are also configured to detect rising edges.
+         *
+         * @note Opening, re-configuring, and closing pins is serialized between threads.
+         * Other functions can be called from any thread once the pin is opened.
          */
         static void open(pinnacle_gpio_t port, bool direction);
 
@@ -108,6 +117,37 @@ namespace cirque_pinnacle_arduino_wrappers {
          */
         static void write(pinnacle_gpio_t port, bool value);
 
+        /**
+         * Wait (without busy-looping) for a rising edge on an input pin.
+         * @param port
+         * @param timeout The maximum number of milliseconds to wait.
+         * @returns true if a rising edge was detected; false if the timeout expired.
+         */
+        static bool waitForEdge(pinnacle_gpio_t port, uint32_t timeout);
+
+        /**
+         * Discard any rising edges on an input pin that were detected but not waited for.
+         * @param port
+         */
+        static void clearEdges(pinnacle_gpio_t port);
+
+        /**
+         * Get the kernel's timestamp of the latest rising edge on an input pin.
+         * @param port
+         * @returns The timestamp (in nanoseconds of CLOCK_MONOTONIC) of the latest rising edge
+         * that was detected since the last call to this function. If no rising edge was detected,
+         * then the current time of CLOCK_MONOTONIC is returned.
+         */
+        static uint64_t edgeTimestamp(pinnacle_gpio_t port);
+
+        /**
+         * Get the file descriptor of an input pin's line request. The file descriptor becomes
+         * readable (for poll() or epoll) when a rising edge is detected.
+         * @param port
+         * @returns The file descriptor. This is owned by the GPIOClass; do not close it.
+         */
+        static int edgeFd(pinnacle_gpio_t port);
+
         virtual ~GPIOClass();
     };
 
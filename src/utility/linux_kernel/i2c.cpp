@@ -18,7 +18,6 @@
  */
 #ifndef ARDUINO
 
-    #include <stdlib.h>    // free(), malloc()
     #include <stddef.h>    // size_t
     #include <stdint.h>    // uintXX_t
     #include <stdio.h>     // sprintf
@@ -37,18 +36,23 @@ extern "C" {
 
 namespace cirque_pinnacle_arduino_wrappers {
 
-    #ifndef PINNACLE_I2C_BUFFER_LENGTH
-        #define PINNACLE_I2C_BUFFER_LENGTH 32
-    #endif
+    // 7-bit I2C addresses never exceed 0x7F
+    #define I2C_NO_SLAVE_SELECTED 0xFF
 
     TwoWire::TwoWire()
-        : xBuffIndex(0), xBuffLen(0), bus_fd(-1)
+        : slaveAddress(I2C_NO_SLAVE_SELECTED), xBuffIndex(0), xBuffLen(0), bus_fd(-1), busNumber(0)
     {
-        xBuff = (uint8_t*)malloc(PINNACLE_I2C_BUFFER_LENGTH);
     }
 
     void TwoWire::begin(uint8_t busNumber)
     {
+        if (bus_fd >= 0) {
+            if (busNumber == this->busNumber) {
+                return; // already opened (possibly for another device on the same bus)
+            }
+            end();
+        }
+
         int file;
         char filename[13];
 
@@ -60,20 +64,32 @@ namespace cirque_pinnacle_arduino_wrappers {
             throw I2CException(msg);
         }
         bus_fd = file;
+        lockFd = file;
+        this->busNumber = busNumber;
+        slaveAddress = I2C_NO_SLAVE_SELECTED;
     }
 
     void TwoWire::end()
     {
+        if (bus_fd < 0) {
+            return;
+        }
         close(bus_fd);
         bus_fd = -1;
+        lockFd = -1;
+        slaveAddress = I2C_NO_SLAVE_SELECTED;
     }
 
     void TwoWire::beginTransmission(uint8_t address)
     {
-        if (ioctl(bus_fd, I2C_SLAVE, address) < 0) {
-            std::string msg = "[TwoWire::beginTransmission] Could not select I2C slave address; ";
-            msg += strerror(errno);
-            throw I2CException(msg);
+        if (address != slaveAddress) {
+            if (ioctl(bus_fd, I2C_SLAVE, address) < 0) {
+                slaveAddress = I2C_NO_SLAVE_SELECTED;
+                std::string msg = "[TwoWire::beginTransmission] Could not select I2C slave address; ";
+                msg += strerror(errno);
+                throw I2CException(msg);
+            }
+            slaveAddress = address;
         }
         xBuffIndex = 0;
         xBuffLen = 0;
@@ -136,9 +152,31 @@ namespace cirque_pinnacle_arduino_wrappers {
         return -1;
     }
 
+    uint8_t TwoWire::writeRead(uint8_t address, const uint8_t* txBuf, uint8_t txLen, uint8_t* rxBuf, uint8_t rxLen)
+    {
+        struct i2c_msg messages[2];
+        messages[0].addr = address;
+        messages[0].flags = 0;
+        messages[0].len = txLen;
+        messages[0].buf = const_cast<uint8_t*>(txBuf);
+        messages[1].addr = address;
+        messages[1].flags = I2C_M_RD;
+        messages[1].len = rxLen;
+        messages[1].buf = rxBuf;
+
+        struct i2c_rdwr_ioctl_data transaction;
+        transaction.msgs = messages;
+        transaction.nmsgs = 2;
+        if (ioctl(bus_fd, I2C_RDWR, &transaction) < 0) {
+            std::string msg = "[TwoWire::writeRead] Could not transfer data over I2C bus; ";
+            msg += strerror(errno);
+            throw I2CException(msg);
+        }
+        return rxLen;
+    }
+
     TwoWire::~TwoWire()
     {
-        free(xBuff);
         end();
     }
 
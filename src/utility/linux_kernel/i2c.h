@@ -22,6 +22,7 @@
 
     #include <cstdint>   // uintXX_t
     #include <stdexcept> // std::exception, std::string
+    #include "bus_lock.h"  // BusLock
 
     #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,14 @@ namespace cirque_pinnacle_arduino_wrappers {
         #define PINNACLE_DEFAULT_I2C_BUS I2C_BUS1
     #endif
 
+    #ifndef PINNACLE_I2C_BUFFER_LENGTH
+        // The size of the internal buffer used for write() and read().
+        #define PINNACLE_I2C_BUFFER_LENGTH 32
+    #endif
+
+    // This driver implements TwoWire::writeRead()
+    #define PINNACLE_I2C_WRITE_READ 1
+
     /** Specific exception for I2C errors */
     class I2CException : public std::runtime_error
     {
@@ -48,14 +57,23 @@ namespace cirque_pinnacle_arduino_wrappers {
         }
     };
 
-    class TwoWire
+    class TwoWire : public BusLock
     {
 
     public:
         /** Instantiate the object for use with the I2C bus. */
         TwoWire();
 
-        /** Initialize the I2C bus' pins. */
+        /**
+         * Initialize the I2C bus' pins.
+         * @param busNumber The I2C bus number (eg. ``1`` for `/dev/i2c-1`).
+         *
+         * @note This does nothing if the specified bus is already opened by this object, so
+         * several devices can share the same object. If a different bus was opened by this
+         * object, then it is closed first. Use separate objects for separate buses; each object
+         * has its own file descriptor, so separate buses can be used from separate threads at the
+         * same time.
+         */
         void begin(uint8_t busNumber = PINNACLE_DEFAULT_I2C_BUS);
 
         /** De-initialize the I2C bus' pins. */
@@ -64,7 +82,8 @@ namespace cirque_pinnacle_arduino_wrappers {
         /**
          * Start a transaction over the bus.
          * @note This will reset the internal buffer used for write().
-         * @param address The slave device's I2C address.
+         * @param address The slave device's I2C address. The bus is only re-configured if this
+         * differs from the previously used address.
          */
         void beginTransmission(uint8_t address);
 
@@ -115,16 +134,31 @@ namespace cirque_pinnacle_arduino_wrappers {
          */
         int read();
 
-        /** free up the allocated memory for internal buffer */
+        /**
+         * Write bytes to and then read bytes from the specified I2C device's address in a
+         * single combined transaction (using a repeated start condition between the write
+         * and the read).
+         * @note This does not use the internal buffer.
+         * @param address The slave device's I2C address.
+         * @param txBuf The bytes to write (eg. the register offset).
+         * @param txLen The number of bytes in `txBuf`.
+         * @param rxBuf The buffer to store the bytes read.
+         * @param rxLen The number of bytes to read.
+         * @return The number of bytes read into `rxBuf`.
+         */
+        uint8_t writeRead(uint8_t address, const uint8_t* txBuf, uint8_t txLen, uint8_t* rxBuf, uint8_t rxLen);
+
+        /** De-initialize the I2C bus (if not already done with `end()`). */
         ~TwoWire();
 
     private:
-        uint8_t slaveAddress;
-        uint8_t* xBuff;
+        uint8_t slaveAddress; // the address currently selected via ioctl(I2C_SLAVE)
+        uint8_t xBuff[PINNACLE_I2C_BUFFER_LENGTH];
         uint8_t xBuffIndex;
         uint8_t xBuffLen;
 
         int bus_fd;
+        uint8_t busNumber; // the bus number opened by begin()
     };
 
     // pre-instantiated I2C bus object (to use as a convenient default)
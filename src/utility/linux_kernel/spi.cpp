@@ -35,17 +35,12 @@ namespace cirque_pinnacle_arduino_wrappers {
     #define PINNACLE_SPI_BITS_PER_WORD 8
 
     SPIClass::SPIClass()
-        : fd(-1), _spi_speed(PINNACLE_SPI_SPEED)
+        : fd(-1), _spi_speed(PINNACLE_SPI_SPEED), queueLen(0)
     {
     }
 
     void SPIClass::begin(int busNumber, SPISettings settings)
     {
-
-        if (spiIsInitialized) {
-            return;
-        }
-
         /* set spidev accordingly to busNumber like:
          * busNumber = 23 -> /dev/spidev2.3
          */
@@ -53,11 +48,7 @@ namespace cirque_pinnacle_arduino_wrappers {
         device[11] += (busNumber / 10) % 10;
         device[13] += busNumber % 10;
 
-        if (fd >= 0) // check whether spi is already open
-        {
-            close(fd);
-            fd = -1;
-        }
+        end(); // close the previously opened device (if any)
 
         fd = open(device, O_RDWR);
         if (fd < 0) {
@@ -67,7 +58,7 @@ namespace cirque_pinnacle_arduino_wrappers {
             msg += strerror(errno);
             throw SPIException(msg);
         }
-        spiIsInitialized = true;
+        lockFd = fd;
 
         int ret;
 
@@ -120,6 +111,16 @@ namespace cirque_pinnacle_arduino_wrappers {
         _spi_speed = settings.clock;
     }
 
+    void SPIClass::end()
+    {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        lockFd = -1;
+        queueLen = 0;
+    }
+
     uint8_t SPIClass::transfer(uint8_t tx)
     {
         struct spi_ioc_transfer tr;
@@ -169,13 +170,46 @@ namespace cirque_pinnacle_arduino_wrappers {
         transfer(buf, buf, len);
     }
 
-    SPIClass::~SPIClass()
+    void SPIClass::queueTransfer(void* tx_buf, void* rx_buf, uint32_t len, bool csChange)
     {
-        if (fd >= 0) {
-            close(fd);
+        if (queueLen >= PINNACLE_SPI_QUEUE_SIZE) {
+            flush();
+        }
+        struct spi_ioc_transfer* tr = &queue[queueLen++];
+        memset(tr, 0, sizeof(*tr));
+        tr->tx_buf = (unsigned long)tx_buf;
+        tr->rx_buf = (unsigned long)rx_buf;
+        tr->len = len;
+        tr->speed_hz = _spi_speed;
+        tr->delay_usecs = 0;
+        tr->bits_per_word = PINNACLE_SPI_BITS_PER_WORD;
+        tr->cs_change = csChange;
+    }
+
+    void SPIClass::flush()
+    {
+        if (!queueLen) {
+            return;
+        }
+        // cs_change on the last transfer would leave CS active after the message
+        queue[queueLen - 1].cs_change = 0;
+        uint8_t n = queueLen;
+        queueLen = 0;
+
+        int ret;
+        ret = ioctl(fd, SPI_IOC_MESSAGE(n), queue);
+        if (ret < 1) {
+            std::string msg = "[SPIClass::flush] Could not transfer queued buffers; ";
+            msg += strerror(errno);
+            throw SPIException(msg);
         }
     }
 
+    SPIClass::~SPIClass()
+    {
+        end();
+    }
+
     SPIClass SPI;
 
 } // namespace cirque_pinnacle_arduino_wrappers
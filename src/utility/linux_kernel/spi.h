@@ -22,6 +22,7 @@
 
     #include <cstdint>   // uintXX_t
     #include <stdexcept> // std::exception, std::string
+    #include "bus_lock.h"  // BusLock
     #include <linux/spi/spidev.h>
 
     #ifdef __cplusplus
@@ -43,6 +44,14 @@ namespace cirque_pinnacle_arduino_wrappers {
     #define PINNACLE_SS_CTRL(pin, value)
     #define PINNACLE_USE_NATIVE_CS
     #define PINNACLE_SPI_BUFFER_OPS 1
+    // This driver implements SPIClass::queueTransfer() and SPIClass::flush()
+    #define PINNACLE_SPI_QUEUED_OPS 1
+
+    #ifndef PINNACLE_SPI_QUEUE_SIZE
+        // The maximum number of transfers that SPIClass::flush() sends in 1 system call.
+        // PinnacleTouchSPI flushes a batch of register accesses before it exceeds this size.
+        #define PINNACLE_SPI_QUEUE_SIZE 8
+    #endif
 
     enum BitOrder : uint8_t
     {
@@ -94,7 +103,7 @@ namespace cirque_pinnacle_arduino_wrappers {
         }
     };
 
-    class SPIClass
+    class SPIClass : public BusLock
     {
     public:
         /** Instantiate an object for use with a single SPi bus. */
@@ -110,10 +119,17 @@ namespace cirque_pinnacle_arduino_wrappers {
          * |    1   |     0     |     10      | /dev/spidev1.0 |
          * |    1   |     1     |     11      | /dev/spidev1.1 |
          * |    1   |     2     |     12      | /dev/spidev1.2 |
-         * @param spi_speed The baudrate (aka frequency) to be used on the specified SPI bus.
+         * @param settings The baudrate (aka frequency) and mode to be used on the specified SPI bus.
+         *
+         * @note Each SPIClass object has its own file descriptor, so objects for different spidev
+         * devices can be used from separate threads at the same time. Calling this again closes the
+         * previously opened device before opening the specified device with the new settings.
          */
         void begin(int busNumber = PINNACLE_DEFAULT_SPI_BUS, SPISettings settings = SPISettings());
 
+        /** Close the spidev device (if it was opened with `begin()`). */
+        void end();
+
         /**
          * Transfer buffers of bytes to/from a SPI slave device.
          * @param tx_buf The pointer to a buffer of bytes to send over MOSI.
@@ -139,13 +155,31 @@ namespace cirque_pinnacle_arduino_wrappers {
          */
         uint8_t transfer(uint8_t tx);
 
+        /**
+         * Queue a transfer of buffers of bytes to/from a SPI slave device. Nothing is sent over
+         * the bus until `flush()` is called (or the queue is full).
+         * @param tx_buf The pointer to a buffer of bytes to send over MOSI.
+         * @param rx_buf The pointer to a buffer of bytes that get received over MISO.
+         * @param len The length of each buffer of bytes; each buffer should have equal length.
+         * @param csChange If true, the CS pin is deactivated after this transfer (before the
+         * next queued transfer begins). The CS pin is always deactivated after the last queued
+         * transfer.
+         *
+         * @note The buffers must remain valid until the queue is flushed.
+         */
+        void queueTransfer(void* tx_buf, void* rx_buf, uint32_t len, bool csChange = true);
+
+        /** Send all queued transfers over the bus with a single system call. */
+        void flush();
+
         /** Clean-up any internal pointers/buffers/etc. */
         ~SPIClass();
 
     private:
         int fd;
         uint32_t _spi_speed;
-        bool spiIsInitialized = false;
+        struct spi_ioc_transfer queue[PINNACLE_SPI_QUEUE_SIZE];
+        uint8_t queueLen;
     };
 
     extern SPIClass SPI;
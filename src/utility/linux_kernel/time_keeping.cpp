@@ -18,7 +18,7 @@
  */
 #ifndef ARDUINO
     #include <time.h>
-    #include <chrono>
+    #include <errno.h> // EINTR
     #include "time_keeping.h"
 
     #ifdef __cplusplus
@@ -27,31 +27,87 @@ extern "C" {
 
 namespace cirque_pinnacle_arduino_wrappers {
 
-    void __msleep(int milliseconds)
+    #ifndef PINNACLE_SPIN_THRESHOLD_MAX
+        // The upper limit (in nanoseconds) for the measured sleep granularity.
+        #define PINNACLE_SPIN_THRESHOLD_MAX 1000000L
+    #endif
+
+    static uint64_t monotonicNow()
     {
-        struct timespec req;
-        req.tv_sec = (time_t)milliseconds / 1000;
-        req.tv_nsec = (milliseconds % 1000) * 1000000L;
-        //nanosleep(&req, (struct timespec *)NULL);
-        clock_nanosleep(CLOCK_REALTIME, 0, &req, NULL);
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
     }
 
-    void __usleep(int microseconds)
+    // Measure how much the scheduler oversleeps a minimal sleep. Delays shorter than this are
+    // done by spinning; longer delays sleep until (deadline - threshold) and spin the rest.
+    // The median of a few samples is used, so one slow sample (on a loaded system) doesn't
+    // make every later delay spin.
+    static uint64_t measureSleepGranularity()
     {
         struct timespec req;
-        req.tv_sec = (time_t)microseconds / 1000000;
-        req.tv_nsec = (microseconds % 1000000) * 1000;
-        //nanosleep(&req, (struct timespec *)NULL);
-        clock_nanosleep(CLOCK_REALTIME, 0, &req, NULL);
+        req.tv_sec = 0;
+        req.tv_nsec = 1000;
+        uint64_t samples[5];
+        for (int i = 0; i < 5; ++i) {
+            uint64_t start = monotonicNow();
+            clock_nanosleep(CLOCK_MONOTONIC, 0, &req, NULL);
+            uint64_t elapsed = monotonicNow() - start;
+            // insertion sort
+            int j = i;
+            for (; j > 0 && samples[j - 1] > elapsed; --j) {
+                samples[j] = samples[j - 1];
+            }
+            samples[j] = elapsed;
+        }
+        uint64_t granularity = samples[2];
+        return granularity > PINNACLE_SPIN_THRESHOLD_MAX ? PINNACLE_SPIN_THRESHOLD_MAX : granularity;
+    }
+
+    static const uint64_t start = monotonicNow();
+
+    static void delayNanoseconds(uint64_t duration)
+    {
+        // measured on the first delay (not when the library is loaded)
+        static const uint64_t spinThreshold = measureSleepGranularity();
+        uint64_t deadline = monotonicNow() + duration;
+        if (duration > spinThreshold) {
+            uint64_t wake = deadline - spinThreshold;
+            struct timespec req;
+            req.tv_sec = (time_t)(wake / 1000000000ULL);
+            req.tv_nsec = (long)(wake % 1000000000ULL);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &req, NULL) == EINTR) {
+                // interrupted by a signal; continue sleeping until the absolute wake time
+            }
+        }
+        while (monotonicNow() < deadline) {
+        }
     }
 
-    auto start = std::chrono::steady_clock::now();
+    void __msleep(int milliseconds)
+    {
+        if (milliseconds <= 0) {
+            return;
+        }
+        delayNanoseconds((uint64_t)milliseconds * 1000000ULL);
+    }
+
+    void __usleep(int microseconds)
+    {
+        if (microseconds <= 0) {
+            return;
+        }
+        delayNanoseconds((uint64_t)microseconds * 1000ULL);
+    }
 
     uint32_t __millis()
     {
-        auto end = std::chrono::steady_clock::now();
+        return (uint32_t)((monotonicNow() - start) / 1000000ULL);
+    }
 
-        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    uint32_t __micros()
+    {
+        return (uint32_t)((monotonicNow() - start) / 1000ULL);
     }
 
 } // namespace cirque_pinnacle_arduino_wrappers
@@ -34,9 +34,12 @@ namespace cirque_pinnacle_arduino_wrappers {
 
     uint32_t __millis();
 
+    uint32_t __micros();
+
     #define delay(ms)             __msleep(ms)
     #define delayMicroseconds(us) __usleep(us)
     #define millis()              __millis()
+    #define micros()              __micros()
 
 } // namespace cirque_pinnacle_arduino_wrappers
 
@@ -18,7 +18,6 @@
  */
 #ifndef ARDUINO
 
-    #include <stdlib.h>
     #include "i2c.h"
 
     #ifdef __cplusplus
@@ -27,14 +26,9 @@ extern "C" {
 
 namespace cirque_pinnacle_arduino_wrappers {
 
-    #ifndef PINNACLE_I2C_BUFFER_LENGTH
-        #define PINNACLE_I2C_BUFFER_LENGTH 32
-    #endif
-
     TwoWire::TwoWire()
         : slaveAddress(0), xBuffIndex(0), xBuffLen(0)
     {
-        xBuff = (uint8_t*)malloc(PINNACLE_I2C_BUFFER_LENGTH);
     }
 
     void TwoWire::begin(i2c_inst_t* hw_i2c, uint sda, uint scl)
@@ -121,8 +115,6 @@ namespace cirque_pinnacle_arduino_wrappers {
 
     TwoWire::~TwoWire()
     {
-        free(xBuff);
-
         i2c_deinit(hw_id);
     }
 
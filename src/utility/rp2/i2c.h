@@ -35,6 +35,12 @@ namespace cirque_pinnacle_arduino_wrappers {
     #else
         #define PINNACLE_DEFAULT_I2C_BUS i2c0
     #endif
+
+    #ifndef PINNACLE_I2C_BUFFER_LENGTH
+        // The size of the internal buffer used for write() and read().
+        #define PINNACLE_I2C_BUFFER_LENGTH 32
+    #endif
+
     class TwoWire
     {
 
@@ -102,13 +108,13 @@ namespace cirque_pinnacle_arduino_wrappers {
          */
         int read();
 
-        /** free up the allocated memory for internal buffer */
+        /** De-initialize the I2C bus. */
         virtual ~TwoWire();
 
     private:
         i2c_inst_t* hw_id;
         uint8_t slaveAddress;
-        uint8_t* xBuff;
+        uint8_t xBuff[PINNACLE_I2C_BUFFER_LENGTH];
         uint8_t xBuffIndex;
         uint8_t xBuffLen;
     };
@@ -31,6 +31,7 @@ namespace cirque_pinnacle_arduino_wrappers {
     #define delay(milisec)          sleep_ms(milisec)
     #define delayMicroseconds(usec) sleep_us(usec)
     #define millis()                to_ms_since_boot(get_absolute_time())
+    #define micros()                (uint32_t) to_us_since_boot(get_absolute_time())
 
 } // namespace cirque_pinnacle_arduino_wrappers
 